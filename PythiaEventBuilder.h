@@ -0,0 +1,111 @@
+// Track and jet selection shared by z01_GeneratePythiaEvents.C and EventServer.C
+//
+// Fills one JEventFrame from the current pythia.event: final-state charged
+// tracks (pT > 0.2 GeV/c, |eta| < 0.8), anti-kT jets (pT > 5 GeV/c, |eta| < 0.8)
+// and the jet index of every track (-1 = not a jet constituent).
+
+#ifndef PYTHIAEVENTBUILDER_H
+#define PYTHIAEVENTBUILDER_H
+
+#include "TMath.h"
+#include "TString.h"
+#include <vector>
+
+#include "Pythia8/Pythia.h"
+#include "fastjet/PseudoJet.hh"
+#include "fastjet/ClusterSequence.hh"
+#include "fastjet/JetDefinition.hh"
+
+#include "jAnaSimple/src/JEventFrame.h"
+
+// Event selection cuts
+const double kBuilderTrackPtMin = 0.2;  // Minimum track pT (GeV/c)
+const double kBuilderEtaMax = 0.8;      // Maximum |eta|
+const double kBuilderJetPtMin = 5.0;    // Minimum jet pT (GeV/c)
+
+// Physics configuration of the jet sample: pp at 5.36 TeV (eCM in GeV), Monash
+// 2013 tune, hard QCD with the given pT-hat range (pTHatMax = -1: no upper limit)
+inline void ConfigurePythia(Pythia8::Pythia& pythia, double pTHatMin = 3.0, double pTHatMax = -1.0,
+                            double eCM = 5360.) {
+    pythia.readString(Form("Beams:eCM = %g", eCM));
+    pythia.readString("Tune:pp = 14");        // Monash 2013 tune
+    pythia.readString("HardQCD:all = on");    // Hard QCD processes
+    pythia.readString(Form("PhaseSpace:pTHatMin = %g", pTHatMin));  // Minimum pT hat
+    pythia.readString(Form("PhaseSpace:pTHatMax = %g", pTHatMax));
+}
+
+// Returns false if the event has no selected tracks
+inline bool BuildPythiaEvent(Pythia8::Pythia& pythia, const fastjet::JetDefinition& jetDef, JEventFrame& ev) {
+    ev.Clear();
+
+    // Collect final state charged particles
+    std::vector<fastjet::PseudoJet> particles;
+    for (int i = 0; i < pythia.event.size(); i++) {
+        Pythia8::Particle& p = pythia.event[i];
+
+        if (!p.isFinal() || !p.isCharged()) continue;
+
+        double pt = p.pT();
+        double eta = p.eta();
+
+        // Apply track cuts
+        if (pt < kBuilderTrackPtMin || TMath::Abs(eta) > kBuilderEtaMax) continue;
+
+        // Store track
+        if (ev.nTracks >= kFrameMaxTracks) break;
+
+        int it = ev.nTracks;
+        ev.track_px[it] = p.px();
+        ev.track_py[it] = p.py();
+        ev.track_pz[it] = p.pz();
+        ev.track_e[it] = p.e();
+        ev.track_pt[it] = pt;
+        ev.track_eta[it] = eta;
+        ev.track_phi[it] = p.phi();
+        ev.track_charge[it] = p.charge();
+        ev.track_id[it] = i;
+
+        // Add to FastJet input
+        fastjet::PseudoJet pj(p.px(), p.py(), p.pz(), p.e());
+        pj.set_user_index(it);
+        particles.push_back(pj);
+
+        ev.nTracks++;
+    }
+
+    // Skip events with no tracks
+    if (ev.nTracks == 0) return false;
+
+    // Find jets using FastJet
+    fastjet::ClusterSequence cs(particles, jetDef);
+    std::vector<fastjet::PseudoJet> jets_fj = fastjet::sorted_by_pt(cs.inclusive_jets(kBuilderJetPtMin));
+
+    // Store jets and tag their constituents
+    for (unsigned int ij = 0; ij < jets_fj.size() && ij < (unsigned int)kFrameMaxJets; ij++) {
+        fastjet::PseudoJet& jet = jets_fj[ij];
+
+        // Apply jet cuts
+        if (TMath::Abs(jet.eta()) > kBuilderEtaMax) continue;
+
+        int jj = ev.nJets;
+        ev.jet_px[jj] = jet.px();
+        ev.jet_py[jj] = jet.py();
+        ev.jet_pz[jj] = jet.pz();
+        ev.jet_e[jj] = jet.e();
+        ev.jet_pt[jj] = jet.pt();
+        ev.jet_eta[jj] = jet.eta();
+        ev.jet_phi[jj] = jet.phi();
+
+        std::vector<fastjet::PseudoJet> constituents = jet.constituents();
+        ev.jet_nConstituents[jj] = constituents.size();
+        for (const auto& c : constituents) {
+            ev.track_jetIndex[c.user_index()] = jj;
+        }
+
+        ev.nJets++;
+    }
+
+    return true;
+}
+
+#endif
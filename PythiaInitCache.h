@@ -0,0 +1,88 @@
+// Cached Pythia initialisation shared by z01_GeneratePythiaEvents.C and draw_jet_pythia.C
+//
+// The expensive part of pythia.init() is the multiparton-interaction (MPI)
+// initialisation. Pythia can write it to a file and reload it later
+// (MultipartonInteractions:reuseInit / initFile). The file name is keyed by an
+// MD5 of all non-default settings (beams, tune, processes, pT-hat cuts, ...)
+// and the Pythia version, so any change of the configuration automatically
+// produces a new cache entry instead of reusing a stale one.
+//
+// Cache directory: $PYTHIA_INIT_CACHE, default "pythia_init_cache"
+// Usage (instead of pythia.init()):
+//     bool ok = InitPythiaCached(pythia);
+
+#ifndef PYTHIAINITCACHE_H
+#define PYTHIAINITCACHE_H
+
+#include "TString.h"
+#include "TSystem.h"
+#include "TMD5.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "Pythia8/Pythia.h"
+
+// Key of the current configuration: MD5 of the changed settings + version
+inline TString PythiaInitCacheKey(Pythia8::Pythia& pythia) {
+    // Do not let a previous cache setup enter the key
+    pythia.settings.resetMode("MultipartonInteractions:reuseInit");
+    pythia.settings.resetWord("MultipartonInteractions:initFile");
+
+    std::ostringstream settings;
+    pythia.settings.writeFile(settings, false);  // only settings that differ from default
+
+    // Random seeds and printout do not change the initialisation products,
+    // so workers with different seeds share one cache entry
+    std::istringstream lines(settings.str());
+    std::string line, config;
+    while (std::getline(lines, line)) {
+        TString lower(line.c_str());
+        lower.ToLower();
+        if (lower.BeginsWith("random:") || lower.BeginsWith("next:")) continue;
+        config += line + "\n";
+    }
+    config += Form("Pythia:versionNumber = %g\n", pythia.settings.parm("Pythia:versionNumber"));
+
+    TMD5 md5;
+    md5.Update((const UChar_t*)config.data(), config.size());
+    md5.Final();
+    return TString(md5.AsString());
+}
+
+// pythia.init() that reuses the MPI initialisation if this configuration was
+// seen before, otherwise initialises normally and saves it for the next run
+// or worker. New entries are written to a per-process file and renamed into
+// place, so concurrent workers never read a half-written cache file. An entry
+// that cannot be read (corrupt, or left by an interrupted or different build)
+// is removed and the initialisation is done again from scratch.
+inline bool InitPythiaCached(Pythia8::Pythia& pythia, const char* cacheDir = 0) {
+    TString dir = cacheDir ? cacheDir : gSystem->Getenv("PYTHIA_INIT_CACHE");
+    if (dir.Length() == 0) dir = "pythia_init_cache";
+    gSystem->mkdir(dir.Data(), kTRUE);
+
+    TString initFile = dir + "/mpi_" + PythiaInitCacheKey(pythia) + ".cmnd";
+    if (!gSystem->AccessPathName(initFile.Data())) {
+        // reuseInit = 2: read the initialisation
+        pythia.readString("MultipartonInteractions:reuseInit = 2");
+        pythia.readString(("MultipartonInteractions:initFile = " + initFile).Data());
+        std::cout << "Pythia init cache: " << initFile << " (reused)" << std::endl;
+        if (pythia.init()) return true;
+
+        std::cout << "Pythia init cache: cannot use " << initFile << ", initialising again" << std::endl;
+        gSystem->Unlink(initFile.Data());
+    }
+
+    // reuseInit = 1: initialise and write it
+    TString writeFile = TString::Format("%s.%d.tmp", initFile.Data(), gSystem->GetPid());
+    pythia.readString("MultipartonInteractions:reuseInit = 1");
+    pythia.readString(("MultipartonInteractions:initFile = " + writeFile).Data());
+    std::cout << "Pythia init cache: " << initFile << " (creating)" << std::endl;
+
+    bool ok = pythia.init();
+    if (ok) gSystem->Rename(writeFile.Data(), initFile.Data());
+    else gSystem->Unlink(writeFile.Data());
+    return ok;
+}
+
+#endif
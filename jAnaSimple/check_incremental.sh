@@ -0,0 +1,37 @@
+#!/bin/bash
+# Incremental mode must give the same raw accumulators as a single pass:
+# analyses two toy-event files once together and once in two incremental
+# steps, then compares SameEvent, MixedEvent and TriggerCounts bin by bin
+# (CompareAccumulators.C). Needs ROOT only (no Pythia/FastJet).
+# Usage: ./check_incremental.sh [nEventsPerFile] [workDir]
+cd "$(dirname "$0")"
+nEvents=${1:-2000}
+work=${2:-check_incremental}
+mkdir -p "$work" || exit 1
+work=$(cd "$work" && pwd)
+
+make -s SimpleCorrelation || exit 1
+
+# Two small files with different seeds; few events, so that some bins have
+# mixed pairs but no same-event pairs after the first step
+for i in 0 1; do
+    (cd .. && root -l -b -q "GenerateToyEvents.C+($nEvents, \"$work/toy$i.root\", \"mean=50,jets=2\", $((i + 1)))") \
+        > "$work/generate$i.log" 2>&1 || { echo "Toy generation failed (see $work/generate$i.log)"; exit 1; }
+done
+echo "$work/toy0.root" > "$work/step1.txt"
+printf '%s\n' "$work/toy0.root" "$work/toy1.root" > "$work/all.txt"
+rm -f "$work/single.root" "$work/incremental.root"
+
+run() {
+    local log=$1
+    shift
+    ./SimpleCorrelation "$@" > "$work/$log.log" 2>&1 || { echo "SimpleCorrelation failed (see $work/$log.log)"; exit 1; }
+}
+run single "$work/all.txt" "$work/single.root"
+run step1 "$work/step1.txt" "$work/incremental.root"
+run step2 "$work/all.txt" "$work/incremental.root" incremental
+
+root -l -b << EOF
+.L CompareAccumulators.C+
+gSystem->Exit(CompareAccumulators("$work/single.root", "$work/incremental.root") > 0 ? 1 : 0);
+EOF
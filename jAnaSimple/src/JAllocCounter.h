@@ -0,0 +1,57 @@
+// $Id: JAllocCounter.h,v 1.0 2026/10/19 djkim Exp $
+////////////////////////////////////////////////////
+/*!
+  \file JAllocCounter.h
+  \brief Process-wide count of heap allocations (operator new)
+  \author D.J.Kim (University of Jyvaskyla)
+  \email: djkim@jyu.fi
+  \version $Revision: 1.0 $
+  \date $Date: 2026/10/19 $
+
+  Counting needs the global operator new to be replaced, which is only
+  well defined in the executable: its main file defines
+  JALLOC_COUNT_OPERATORS before including this header (SimpleMain.C).
+  Libraries and macros only read the counter; without the executable's
+  replacement JAllocCounter::IsEnabled() is false.
+ */
+////////////////////////////////////////////////////
+
+#ifndef JALLOCCOUNTER_H
+#define JALLOCCOUNTER_H
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace JAllocCounter {
+	inline std::atomic<unsigned long long>& Counter() {
+		static std::atomic<unsigned long long> count(0);
+		return count;
+	}
+	inline std::atomic<bool>& Enabled() {
+		static std::atomic<bool> enabled(false);
+		return enabled;
+	}
+	inline bool IsEnabled() { return Enabled().load(std::memory_order_relaxed); }
+	inline unsigned long long Get() { return Counter().load(std::memory_order_relaxed); }
+}
+
+#ifdef JALLOC_COUNT_OPERATORS
+void* operator new(std::size_t size) {
+	JAllocCounter::Counter().fetch_add(1, std::memory_order_relaxed);
+	if( size == 0 ) size = 1;
+	if( void* p = std::malloc(size) ) return p;
+	throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+static struct JAllocCounterSwitch {
+	JAllocCounterSwitch() { JAllocCounter::Enabled() = true; }
+} gJAllocCounterSwitch;
+#endif
+
+#endif
@@ -19,7 +19,8 @@ JBaseTrack::JBaseTrack():
     fLabel(-9999), 
     fParticleType(-1), 
     fCharge(0), 
-    fStatus(0)
+    fStatus(0),
+    fJetMask(0)
 {
   // constructor
 }
@@ -31,7 +32,8 @@ JBaseTrack::JBaseTrack(float px,float py, float pz, float e, Int_t id, Short_t p
     fLabel(-9999),
     fParticleType(ptype), 
     fCharge(charge), 
-    fStatus(0)
+    fStatus(0),
+    fJetMask(0)
 {
   // constructor
 }
@@ -43,7 +45,8 @@ JBaseTrack::JBaseTrack(const JBaseTrack& a):
     fLabel          (a.fLabel),
     fParticleType   ( a.fParticleType ), 
     fCharge         ( a.fCharge ), 
-    fStatus         ( a.fStatus ) 
+    fStatus         ( a.fStatus ),
+    fJetMask        ( a.fJetMask )
 {
   //copy constructor
 }
@@ -55,7 +58,8 @@ JBaseTrack::JBaseTrack(const TLorentzVector& a):
     fLabel          ( -9999 ),
     fParticleType   ( -1 ),
     fCharge         ( 0 ),
-    fStatus         ( 0 )
+    fStatus         ( 0 ),
+    fJetMask        ( 0 )
 {
   //copy constructor
 }
@@ -69,6 +73,7 @@ JBaseTrack& JBaseTrack::operator=(const JBaseTrack& trk){
     fParticleType = trk.fParticleType;
     fCharge       = trk.fCharge;
     fStatus       = trk.fStatus;
+    fJetMask      = trk.fJetMask;
   }
   return *this;
 }
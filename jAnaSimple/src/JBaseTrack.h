@@ -37,12 +37,14 @@ class JBaseTrack : public TLorentzVector {
         Int_t         GetLabel()        const { return fLabel; }
         Short_t       GetParticleType() const { return fParticleType;}
         ULong_t       GetStatus()       const { return fStatus; }
+        ULong64_t     GetJetMask()      const { return fJetMask; }  // bit j = constituent of jet j, 0 = not in a jet
         Short_t       GetCharge()       const { return fCharge; } 
 
         void SetID      (const int id){fID=id;}
         void SetLabel   (const Int_t label ){ fLabel=label; }
         void SetParticleType(const Short_t ptype){ fParticleType=ptype; }
         void SetStatus  (const ULong_t status){ fStatus=status; }
+        void SetJetMask (const ULong64_t mask){ fJetMask=mask; }
         void SetCharge  (const Char_t charge){ fCharge=charge; }
 
         virtual void Print(Option_t *option="") const;
@@ -56,8 +58,9 @@ class JBaseTrack : public TLorentzVector {
         Short_t       fParticleType;  // ParticleType 
         Char_t        fCharge;        // track charge for real data
         ULong_t       fStatus;        // reconstruction status flags or MC status 
+        ULong64_t     fJetMask;       // jets of the event the track is a constituent of (bit j = jet j)
 
-        ClassDef(JBaseTrack,1)
+        ClassDef(JBaseTrack,2)
 };
 
 #endif
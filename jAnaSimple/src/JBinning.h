@@ -0,0 +1,97 @@
+// $Id: JBinning.h,v 1.0 2026/10/19 djkim Exp $
+////////////////////////////////////////////////////
+/*!
+  \file JBinning.h
+  \brief pT and multiplicity bins shared by SimpleCorrelation and the
+         post-processing macros (z03, z04, z03.fitYield.C)
+  \author D.J.Kim (University of Jyvaskyla)
+  \email: djkim@jyu.fi
+  \version $Revision: 1.0 $
+  \date $Date: 2026/10/19 $
+
+  Every stage takes its bin edges from here, so they cannot disagree.
+  The edges are constexpr and StaticBins specialises the lookup for them
+  at compile time: a value -> bin table when all edges are integers and
+  span at most kMaxTableSize (the pT and multiplicity bins), otherwise a
+  branch-free count of the edges below the value. FindBin() is the
+  fallback for edges known only at run time.
+ */
+////////////////////////////////////////////////////
+
+#ifndef JBINNING_H
+#define JBINNING_H
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <vector>
+
+namespace JBinning {
+	inline constexpr double kPtTrigEdges[] = {1.0, 2.0, 3.0, 4.0, 8.0};
+	inline constexpr double kPtAssocEdges[] = {1.0, 2.0, 3.0, 4.0, 8.0};
+	inline constexpr double kMultEdges[] = {0, 5, 10, 20, 30, 40, 50, 60, 100.0};
+
+	inline constexpr int kMaxTableSize = 4096;   // entries of a lookup table
+
+	// Bin of value, -1 outside [edges.front(), edges.back())
+	inline int FindBin( double value, const std::vector<double>& edges ) {
+		if( edges.size() < 2 || !(value >= edges.front() && value < edges.back()) ) return -1;
+		return std::upper_bound(edges.begin(), edges.end(), value) - edges.begin() - 1;
+	}
+
+	namespace Detail {
+		constexpr bool UseTable( const double* edges, int nEdges ) {
+			if( nEdges - 1 > 127 || edges[nEdges-1] - edges[0] > kMaxTableSize ) return false;
+			for( int i = 0; i < nEdges; i++ ) {
+				if( edges[i] != (long long)edges[i] ) return false;
+			}
+			return true;
+		}
+
+		// table[k] = bin of edges[0] + k; with integer edges that is the bin of
+		// every value in [edges[0] + k, edges[0] + k + 1)
+		template <int N>
+		constexpr std::array<signed char, N> MakeTable( const double* edges ) {
+			std::array<signed char, N> table{};
+			int bin = 0;
+			for( int k = 0; k < N; k++ ) {
+				while( edges[0] + k >= edges[bin+1] ) bin++;
+				table[k] = bin;
+			}
+			return table;
+		}
+	}
+
+	template <const double* Edges, int NEdges>
+	class StaticBins {
+		public:
+			static constexpr int kNBins = NEdges - 1;
+			static constexpr bool kUseTable = Detail::UseTable(Edges, NEdges);
+
+			// Bin of value, -1 outside (NaN included)
+			static int Find( double value ) {
+				if( !(value >= Edges[0] && value < Edges[NEdges-1]) ) return -1;
+				if constexpr( kUseTable ) {
+					return kTable[int(value - Edges[0])];
+				} else {
+					int bin = -1;
+					for( int i = 0; i < NEdges - 1; i++ ) bin += (value >= Edges[i]);
+					return bin;
+				}
+			}
+
+			static double Low( int bin ) { return Edges[bin]; }
+			static double Up( int bin ) { return Edges[bin+1]; }
+			static std::vector<double> GetEdges() { return std::vector<double>(Edges, Edges + NEdges); }
+
+		private:
+			static constexpr int kTableSize = kUseTable ? int(Edges[NEdges-1] - Edges[0]) : 1;
+			static constexpr std::array<signed char, kTableSize> kTable = Detail::MakeTable<kTableSize>(Edges);
+	};
+
+	typedef StaticBins<kPtTrigEdges, std::size(kPtTrigEdges)> PtTrig;
+	typedef StaticBins<kPtAssocEdges, std::size(kPtAssocEdges)> PtAssoc;
+	typedef StaticBins<kMultEdges, std::size(kMultEdges)> Mult;
+}
+
+#endif
@@ -0,0 +1,229 @@
+// $Id: JCorrelationTools.h,v 1.0 2026/10/19 djkim Exp $
+////////////////////////////////////////////////////
+/*!
+  \file JCorrelationTools.h
+  \brief Histogram naming, trigger counts, normalisation and the
+         multiplicity-integrated output shared by
+         SimpleCorrelation and MergeCorrelation
+  \author D.J.Kim (University of Jyvaskyla)
+  \email: djkim@jyu.fi
+  \version $Revision: 1.0 $
+  \date $Date: 2026/10/19 $
+
+  Only the raw accumulators (Same, Mixed, trigger counts) are additive.
+  The correlation C = (1/N_trig) S/(alpha M) is always recomputed from them,
+  in the engine and after merging shards. Both also write the
+  multiplicity-integrated correlations with an index (Integrated/), which
+  the post-processing macros read by name.
+ */
+////////////////////////////////////////////////////
+
+#ifndef JCORRELATIONTOOLS_H
+#define JCORRELATIONTOOLS_H
+
+#include <cstring>
+#include <vector>
+
+#include <TString.h>
+#include <TH2F.h>
+#include <TH3D.h>
+#include <TMath.h>
+#include <TTree.h>
+#include <TDirectory.h>
+
+// Helper function to create histogram name
+inline TString GetHistName(const char* base, int iTrig, int iAssoc, int iMult) {
+	return TString::Format("%s_trig%d_assoc%d_mult%d", base, iTrig, iAssoc, iMult);
+}
+
+// Helper function to create histogram name with jet category
+inline TString GetHistNameWithJetCategory(const char* base, const char* jetCat, int iTrig, int iAssoc, int iMult) {
+	return TString::Format("%s_%s_trig%d_assoc%d_mult%d", base, jetCat, iTrig, iAssoc, iMult);
+}
+
+// C = (1/N_trig) * S / (alpha * M), alpha = Integral(S) / Integral(M).
+// With weights, relative errors of S, M (sum w^2) and N_trig are added in quadrature;
+// a mixed-event histogram without sum w^2 (memory budget) adds no error, the
+// pools make it much larger than the same-event sample.
+// withOverflow: the histograms cover only a window (statistical replicas) and the
+// pairs outside it are in the under/overflow bins, which then enter alpha.
+inline void FillCorrelation(TH2F* hSame, TH2F* hMixed, TH2F* hRatio, double nTrig, double nTrigW2, bool useWeights,
+		bool withOverflow = false) {
+	// Skip if no entries
+	if (hSame->GetEntries() == 0 || hMixed->GetEntries() == 0) return;
+
+	int nx = hSame->GetNbinsX(), ny = hSame->GetNbinsY();
+	double integralSame = withOverflow ? hSame->Integral(0, nx+1, 0, ny+1) : hSame->Integral();
+	double integralMixed = withOverflow ? hMixed->Integral(0, nx+1, 0, ny+1) : hMixed->Integral();
+	double alpha = (integralMixed > 0) ? integralSame / integralMixed : 0.0;
+
+	for (int xBin = 1; xBin <= hRatio->GetNbinsX(); xBin++) {
+		for (int yBin = 1; yBin <= hRatio->GetNbinsY(); yBin++) {
+			double same = hSame->GetBinContent(xBin, yBin);
+			double mixed = hMixed->GetBinContent(xBin, yBin);
+
+			if (mixed > 0 && nTrig > 0 && alpha > 0) {
+				double corr = (1.0 / nTrig) * (same / (alpha * mixed));
+				hRatio->SetBinContent(xBin, yBin, corr);
+				if (useWeights && same > 0) {
+					double eSame = hSame->GetBinError(xBin, yBin) / same;
+					double eMixed = hMixed->GetSumw2N() > 0 ? hMixed->GetBinError(xBin, yBin) / mixed : 0.0;
+					double eTrig2 = nTrigW2 / (nTrig * nTrig);
+					hRatio->SetBinError(xBin, yBin, corr * TMath::Sqrt(eSame*eSame + eMixed*eMixed + eTrig2));
+				}
+			}
+		}
+	}
+}
+
+typedef std::vector<std::vector<std::vector<double>>> TriggerCountArray;  // [trig][assoc][mult]
+
+// Set the bins of a trigger count histogram (MakeTriggerCountHist) from the counts
+inline void FillTriggerCountHist(TH3D* h, const TriggerCountArray& counts, const TriggerCountArray& countsW2) {
+	for (size_t iTrig = 0; iTrig < counts.size(); iTrig++) {
+		for (size_t iAssoc = 0; iAssoc < counts[iTrig].size(); iAssoc++) {
+			for (size_t iMult = 0; iMult < counts[iTrig][iAssoc].size(); iMult++) {
+				h->SetBinContent(iTrig+1, iAssoc+1, iMult+1, counts[iTrig][iAssoc][iMult]);
+				h->SetBinError(iTrig+1, iAssoc+1, iMult+1, TMath::Sqrt(countsW2[iTrig][iAssoc][iMult]));
+			}
+		}
+	}
+}
+
+// Trigger counts as TH3D over (trigger pT, associated pT, multiplicity) bins:
+// content = sum of weights, error^2 = sum of weights squared, so that the
+// counts of several shards simply add up
+inline TH3D* MakeTriggerCountHist(const char* name, const std::vector<double>& trigBins,
+		const std::vector<double>& assocBins, const std::vector<double>& multBins,
+		const TriggerCountArray& counts, const TriggerCountArray& countsW2) {
+	TH3D* h = new TH3D(name, "Number of triggers;p_{T}^{trig};p_{T}^{assoc};multiplicity",
+			trigBins.size()-1, trigBins.data(), assocBins.size()-1, assocBins.data(),
+			multBins.size()-1, multBins.data());
+	h->Sumw2();
+	FillTriggerCountHist(h, counts, countsW2);
+	return h;
+}
+
+// Sum of weights and of weights squared for one (trig, assoc, mult) bin
+inline double GetTriggerCount(const TH3D* h, int iTrig, int iAssoc, int iMult) {
+	return h ? h->GetBinContent(iTrig+1, iAssoc+1, iMult+1) : 0.0;
+}
+
+inline double GetTriggerCountW2(const TH3D* h, int iTrig, int iAssoc, int iMult) {
+	if (!h) return 0.0;
+	double e = h->GetBinError(iTrig+1, iAssoc+1, iMult+1);
+	return e * e;
+}
+
+// Multiplicity-integrated correlation: trigger-weighted average of the
+// correlations of the multiplicity bins, each corrected with the mixed event
+// of its own bin, C = sum_m N_m C_m / sum_m N_m. Bins without histograms or
+// triggers are skipped; 0 if no bin has triggers.
+inline TH2F* MakeIntegratedCorrelation(const char* name, const char* title,
+		const std::vector<TH2F*>& same, const std::vector<TH2F*>& mixed,
+		const std::vector<double>& nTrig, const std::vector<double>& nTrigW2,
+		bool useWeights, bool withOverflow = false) {
+	TH2F* hIntegrated = 0;
+	TH2F* hBin = 0;
+	double nTrigSum = 0;
+	for (size_t iMult = 0; iMult < same.size(); iMult++) {
+		if (!same[iMult] || !mixed[iMult] || nTrig[iMult] <= 0) continue;
+		if (!hIntegrated) {
+			hIntegrated = (TH2F*)same[iMult]->Clone(name);
+			hIntegrated->Reset();
+			hIntegrated->SetTitle(title);
+			hBin = (TH2F*)hIntegrated->Clone(TString(name) + "_bin");
+		}
+		hBin->Reset();
+		FillCorrelation(same[iMult], mixed[iMult], hBin, nTrig[iMult], nTrigW2[iMult], useWeights, withOverflow);
+		hIntegrated->Add(hBin, nTrig[iMult]);
+		nTrigSum += nTrig[iMult];
+	}
+	delete hBin;
+	if (!hIntegrated) return 0;
+	hIntegrated->Scale(1.0 / nTrigSum);
+	if (!useWeights) hIntegrated->Sumw2(kFALSE);  // errors as for the correlations per bin
+	return hIntegrated;
+}
+
+// Names in Integrated/: hRatio_<category>_trig<i>_assoc<j>, hRatio_trig<i>_assoc<j> for the inclusive sample
+inline TString GetIntegratedName(const char* category, int iTrig, int iAssoc) {
+	if (!category || !category[0]) return TString::Format("hRatio_trig%d_assoc%d", iTrig, iAssoc);
+	return TString::Format("hRatio_%s_trig%d_assoc%d", category, iTrig, iAssoc);
+}
+
+inline TString GetIntegratedTitle(const char* category, int iTrig, int iAssoc,
+		const std::vector<double>& trigBins, const std::vector<double>& assocBins) {
+	return TString::Format("Correlation %s%s(%.1f < p_{T}^{trig} < %.1f, %.1f < p_{T}^{assoc} < %.1f, all multiplicities);#Delta#eta;#Delta#phi",
+			category ? category : "", (category && category[0]) ? " " : "",
+			trigBins[iTrig], trigBins[iTrig+1], assocBins[iAssoc], assocBins[iAssoc+1]);
+}
+
+// One correlation of Integrated/, as listed in Integrated/Index
+struct IntegratedEntry {
+	TString name;
+	TString category;   // jet category, "" = inclusive
+	int iTrig;
+	int iAssoc;
+	double nTriggers;   // sum of the trigger weights over all multiplicity bins
+};
+
+// Index of Integrated/: one tree entry per written correlation with its bins,
+// pT ranges and trigger count
+inline void WriteIntegratedIndex(TDirectory* dir, const std::vector<IntegratedEntry>& entries,
+		const std::vector<double>& trigBins, const std::vector<double>& assocBins) {
+	dir->cd();
+	TTree* index = new TTree("Index", "Multiplicity-integrated correlations");
+	char name[128], category[32];
+	int iTrig, iAssoc;
+	double ptTrigMin, ptTrigMax, ptAssocMin, ptAssocMax, nTriggers;
+	index->Branch("name", name, "name/C");
+	index->Branch("category", category, "category/C");
+	index->Branch("iTrig", &iTrig, "iTrig/I");
+	index->Branch("iAssoc", &iAssoc, "iAssoc/I");
+	index->Branch("ptTrigMin", &ptTrigMin, "ptTrigMin/D");
+	index->Branch("ptTrigMax", &ptTrigMax, "ptTrigMax/D");
+	index->Branch("ptAssocMin", &ptAssocMin, "ptAssocMin/D");
+	index->Branch("ptAssocMax", &ptAssocMax, "ptAssocMax/D");
+	index->Branch("nTriggers", &nTriggers, "nTriggers/D");
+	for (const auto& entry : entries) {
+		strncpy(name, entry.name.Data(), sizeof(name) - 1);
+		name[sizeof(name) - 1] = 0;
+		strncpy(category, entry.category.Data(), sizeof(category) - 1);
+		category[sizeof(category) - 1] = 0;
+		iTrig = entry.iTrig;
+		iAssoc = entry.iAssoc;
+		ptTrigMin = trigBins[iTrig];
+		ptTrigMax = trigBins[iTrig+1];
+		ptAssocMin = assocBins[iAssoc];
+		ptAssocMax = assocBins[iAssoc+1];
+		nTriggers = entry.nTriggers;
+		index->Fill();
+	}
+	index->Write();
+	delete index;
+}
+
+// Counterpart of WriteIntegratedIndex; false if there is no index (older outputs)
+inline bool ReadIntegratedIndex(TDirectory* dir, std::vector<IntegratedEntry>& entries) {
+	TTree* index = dir ? (TTree*)dir->Get("Index") : 0;
+	if (!index) return false;
+	char name[128], category[32];
+	int iTrig, iAssoc;
+	double nTriggers;
+	index->SetBranchAddress("name", name);
+	index->SetBranchAddress("category", category);
+	index->SetBranchAddress("iTrig", &iTrig);
+	index->SetBranchAddress("iAssoc", &iAssoc);
+	index->SetBranchAddress("nTriggers", &nTriggers);
+	entries.clear();
+	for (Long64_t i = 0; i < index->GetEntries(); i++) {
+		index->GetEntry(i);
+		IntegratedEntry entry = {name, category, iTrig, iAssoc, nTriggers};
+		entries.push_back(entry);
+	}
+	delete index;
+	return true;
+}
+
+#endif
@@ -0,0 +1,229 @@
+// $Id: JEventFrame.h,v 1.0 2026/10/19 djkim Exp $
+////////////////////////////////////////////////////
+/*!
+  \file JEventFrame.h
+  \brief Clustered Pythia event record and binary framing for the event server
+  \author D.J.Kim (University of Jyvaskyla)
+  \email: djkim@jyu.fi
+  \version $Revision: 1.0 $
+  \date $Date: 2026/10/19 $
+
+  JEventFrame has the same fixed-size array layout as the "events" tree
+  written by z01_GeneratePythiaEvents.C, so the generator, the event server
+  (EventServer.C) and the readers share one definition.
+
+  Socket protocol (Unix-domain stream socket, native byte order):
+    client -> server : uint32 nEvents requested (0 = close connection)
+    server -> client : batches until nEvents are delivered
+        header : uint32 magic, uint32 version, uint32 nEvents, uint32 payload bytes
+        event  : int32 eventID, nTracks, nJets, float weight,
+                 nTracks x (float px,py,pz,e,pt,eta,phi; int32 charge,id; int8 jetIndex)
+                 nJets   x (float px,py,pz,e,pt,eta,phi; int32 nConstituents)
+ */
+////////////////////////////////////////////////////
+
+#ifndef JEVENTFRAME_H
+#define JEVENTFRAME_H
+
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+// Limits of one event, shared by the tree layout, the readers' branch arrays
+// and the jet masks of the tracks (JBaseTrack::GetJetMask, one bit per jet)
+const int kFrameMaxTracks = 1000;
+const int kFrameMaxJets = 20;
+static_assert(kFrameMaxJets <= 64, "jet masks have 64 bits");
+const uint32_t kFrameMagic = 0x4A455642;  // "JEVB"
+const uint32_t kFrameVersion = 1;
+const uint32_t kFrameMaxBatchEvents = 10000;  // events per batch accepted by ReadFrameBatch
+// Compact sizes of one event (see the protocol above), for checking received frames
+const size_t kFrameEventBytes = 3 * sizeof(int32_t) + sizeof(float);
+const size_t kFrameTrackBytes = 7 * sizeof(float) + 2 * sizeof(int32_t) + sizeof(signed char);
+const size_t kFrameJetBytes = 7 * sizeof(float) + sizeof(int32_t);
+
+struct JEventFrame {
+	int eventID;
+	int nTracks;
+	int nJets;
+	float weight;
+
+	float track_px[kFrameMaxTracks], track_py[kFrameMaxTracks], track_pz[kFrameMaxTracks], track_e[kFrameMaxTracks];
+	float track_pt[kFrameMaxTracks], track_eta[kFrameMaxTracks], track_phi[kFrameMaxTracks];
+	int track_charge[kFrameMaxTracks], track_id[kFrameMaxTracks];
+	signed char track_jetIndex[kFrameMaxTracks];  // index of the jet the track belongs to, -1 = none
+
+	float jet_px[kFrameMaxJets], jet_py[kFrameMaxJets], jet_pz[kFrameMaxJets], jet_e[kFrameMaxJets];
+	float jet_pt[kFrameMaxJets], jet_eta[kFrameMaxJets], jet_phi[kFrameMaxJets];
+	int jet_nConstituents[kFrameMaxJets];
+
+	void Clear() {
+		eventID = nTracks = nJets = 0;
+		weight = 1.0;
+		memset(track_px, 0, sizeof(track_px)); memset(track_py, 0, sizeof(track_py));
+		memset(track_pz, 0, sizeof(track_pz)); memset(track_e, 0, sizeof(track_e));
+		memset(track_pt, 0, sizeof(track_pt)); memset(track_eta, 0, sizeof(track_eta));
+		memset(track_phi, 0, sizeof(track_phi));
+		memset(track_charge, 0, sizeof(track_charge)); memset(track_id, 0, sizeof(track_id));
+		memset(track_jetIndex, -1, sizeof(track_jetIndex));
+		memset(jet_px, 0, sizeof(jet_px)); memset(jet_py, 0, sizeof(jet_py));
+		memset(jet_pz, 0, sizeof(jet_pz)); memset(jet_e, 0, sizeof(jet_e));
+		memset(jet_pt, 0, sizeof(jet_pt)); memset(jet_eta, 0, sizeof(jet_eta));
+		memset(jet_phi, 0, sizeof(jet_phi));
+		memset(jet_nConstituents, 0, sizeof(jet_nConstituents));
+	}
+};
+
+//______________________________________________________________________________
+// Blocking read/write of exactly n bytes; false on EOF or error
+inline bool FrameReadN(int fd, void* buf, size_t n) {
+	char* p = (char*)buf;
+	while (n > 0) {
+		ssize_t r = read(fd, p, n);
+		if (r <= 0) return false;
+		p += r; n -= r;
+	}
+	return true;
+}
+
+inline bool FrameWriteN(int fd, const void* buf, size_t n) {
+	const char* p = (const char*)buf;
+	while (n > 0) {
+		ssize_t w = write(fd, p, n);
+		if (w <= 0) return false;
+		p += w; n -= w;
+	}
+	return true;
+}
+
+//______________________________________________________________________________
+// Append/extract one event in compact form (only the filled tracks and jets)
+template<typename T> inline void FramePut(std::vector<char>& buf, const T& v) {
+	const char* p = (const char*)&v;
+	buf.insert(buf.end(), p, p + sizeof(T));
+}
+
+template<typename T> inline T FrameGet(const char*& p) {
+	T v;
+	memcpy(&v, p, sizeof(T));
+	p += sizeof(T);
+	return v;
+}
+
+inline void EncodeEventFrame(const JEventFrame& ev, std::vector<char>& buf) {
+	FramePut<int32_t>(buf, ev.eventID);
+	FramePut<int32_t>(buf, ev.nTracks);
+	FramePut<int32_t>(buf, ev.nJets);
+	FramePut<float>(buf, ev.weight);
+	for (int i = 0; i < ev.nTracks; i++) {
+		FramePut(buf, ev.track_px[i]); FramePut(buf, ev.track_py[i]); FramePut(buf, ev.track_pz[i]);
+		FramePut(buf, ev.track_e[i]); FramePut(buf, ev.track_pt[i]); FramePut(buf, ev.track_eta[i]);
+		FramePut(buf, ev.track_phi[i]);
+		FramePut<int32_t>(buf, ev.track_charge[i]); FramePut<int32_t>(buf, ev.track_id[i]);
+		FramePut<signed char>(buf, ev.track_jetIndex[i]);
+	}
+	for (int i = 0; i < ev.nJets; i++) {
+		FramePut(buf, ev.jet_px[i]); FramePut(buf, ev.jet_py[i]); FramePut(buf, ev.jet_pz[i]);
+		FramePut(buf, ev.jet_e[i]); FramePut(buf, ev.jet_pt[i]); FramePut(buf, ev.jet_eta[i]);
+		FramePut(buf, ev.jet_phi[i]);
+		FramePut<int32_t>(buf, ev.jet_nConstituents[i]);
+	}
+}
+
+// Reads one event from [p, end); false, with ev empty, if the counts exceed the
+// frame limits or the event does not fit in what is left of the payload
+inline bool DecodeEventFrame(const char*& p, const char* end, JEventFrame& ev) {
+	ev.Clear();
+	if ((size_t)(end - p) < kFrameEventBytes) return false;
+	const char* start = p;
+	const int32_t eventID = FrameGet<int32_t>(p);
+	const int32_t nTracks = FrameGet<int32_t>(p);
+	const int32_t nJets = FrameGet<int32_t>(p);
+	if (nTracks < 0 || nTracks > kFrameMaxTracks || nJets < 0 || nJets > kFrameMaxJets ||
+	    (size_t)(end - start) < kFrameEventBytes + nTracks * kFrameTrackBytes + nJets * kFrameJetBytes) {
+		p = start;
+		return false;
+	}
+	ev.eventID = eventID;
+	ev.nTracks = nTracks;
+	ev.nJets = nJets;
+	ev.weight = FrameGet<float>(p);
+	for (int i = 0; i < ev.nTracks; i++) {
+		ev.track_px[i] = FrameGet<float>(p); ev.track_py[i] = FrameGet<float>(p); ev.track_pz[i] = FrameGet<float>(p);
+		ev.track_e[i] = FrameGet<float>(p); ev.track_pt[i] = FrameGet<float>(p); ev.track_eta[i] = FrameGet<float>(p);
+		ev.track_phi[i] = FrameGet<float>(p);
+		ev.track_charge[i] = FrameGet<int32_t>(p); ev.track_id[i] = FrameGet<int32_t>(p);
+		ev.track_jetIndex[i] = FrameGet<signed char>(p);
+	}
+	for (int i = 0; i < ev.nJets; i++) {
+		ev.jet_px[i] = FrameGet<float>(p); ev.jet_py[i] = FrameGet<float>(p); ev.jet_pz[i] = FrameGet<float>(p);
+		ev.jet_e[i] = FrameGet<float>(p); ev.jet_pt[i] = FrameGet<float>(p); ev.jet_eta[i] = FrameGet<float>(p);
+		ev.jet_phi[i] = FrameGet<float>(p);
+		ev.jet_nConstituents[i] = FrameGet<int32_t>(p);
+	}
+	return true;
+}
+
+//______________________________________________________________________________
+// One batch = header + concatenated compact events
+inline bool WriteFrameBatch(int fd, const std::vector<char>& payload, uint32_t nEvents) {
+	uint32_t header[4] = {kFrameMagic, kFrameVersion, nEvents, (uint32_t)payload.size()};
+	return FrameWriteN(fd, header, sizeof(header)) && FrameWriteN(fd, payload.data(), payload.size());
+}
+
+// Reads one batch into events (resized to the batch size); false on EOF or a bad
+// frame: wrong magic or version, more than kFrameMaxBatchEvents events, a payload
+// size impossible for nEvents events, an event over the limits or not ending
+// exactly at the end of the payload.
+// events is empty after a failure.
+inline bool ReadFrameBatch(int fd, std::vector<JEventFrame>& events, std::vector<char>& payload) {
+	events.clear();
+	uint32_t header[4];
+	if (!FrameReadN(fd, header, sizeof(header))) return false;
+	if (header[0] != kFrameMagic || header[1] != kFrameVersion) return false;
+	const uint64_t maxEventBytes = kFrameEventBytes + kFrameMaxTracks * kFrameTrackBytes + kFrameMaxJets * kFrameJetBytes;
+	if (header[2] > kFrameMaxBatchEvents || header[3] < (uint64_t)header[2] * kFrameEventBytes ||
+	    header[3] > (uint64_t)header[2] * maxEventBytes) return false;
+	payload.resize(header[3]);
+	if (!FrameReadN(fd, payload.data(), payload.size())) return false;
+	events.resize(header[2]);
+	const char* p = payload.data();
+	const char* end = p + payload.size();
+	for (uint32_t i = 0; i < header[2]; i++) {
+		if (!DecodeEventFrame(p, end, events[i])) {
+			events.clear();
+			return false;
+		}
+	}
+	if (p != end) {
+		events.clear();
+		return false;
+	}
+	return true;
+}
+
+//______________________________________________________________________________
+// Client side: connect to the event server socket, -1 on failure
+inline int ConnectEventServer(const char* socketPath) {
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0) return -1;
+	sockaddr_un addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strncpy(addr.sun_path, socketPath, sizeof(addr.sun_path) - 1);
+	if (connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+// Client side: ask for nEvents more events (0 closes the connection)
+inline bool RequestEvents(int fd, uint32_t nEvents) {
+	return FrameWriteN(fd, &nEvents, sizeof(nEvents));
+}
+
+#endif
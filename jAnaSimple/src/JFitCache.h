@@ -0,0 +1,209 @@
+// $Id: JFitCache.h,v 1.0 2026/10/19 djkim Exp $
+////////////////////////////////////////////////////
+/*!
+  \file JFitCache.h
+  \brief Fit results kept on disk, keyed by a hash of the fitted histogram,
+         the model and its fit options
+  \author D.J.Kim (University of Jyvaskyla)
+  \email: djkim@jyu.fi
+  \version $Revision: 1.0 $
+  \date $Date: 2026/10/19 $
+
+  The key is an MD5 of a model description (function, version, window,
+  limits, options, starting values), the ROOT version, the binning, the
+  number of entries and every bin content and error. A fit whose key is in
+  the cache is not repeated, so rerunning z03_ExtractQuantification.C or
+  z03.fitYield.C on unchanged input (or after changing only the output
+  formatting) costs no fitting; changed histograms are refitted.
+
+  Cache file: $FIT_CACHE/<name>.txt, default directory "fit_cache",
+  FIT_CACHE=none switches the cache off. One line per fit, the key and the
+  values with 17 digits, so cached results are the same numbers as fitted
+  ones. Save() merges with what other runs added meanwhile and renames a
+  per-process file into place.
+ */
+////////////////////////////////////////////////////
+
+#ifndef JFITCACHE_H
+#define JFITCACHE_H
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <TString.h>
+#include <TSystem.h>
+#include <TROOT.h>
+#include <TMD5.h>
+#include <TH1.h>
+#include <TF1.h>
+#include <TList.h>
+#include <TArrayD.h>
+#include <TFitResultPtr.h>
+
+class JFitCache {
+public:
+	JFitCache(const char* name, const char* cacheDir = 0) : fNHits(0), fNMisses(0), fChanged(false) {
+		TString dir = cacheDir ? cacheDir : gSystem->Getenv("FIT_CACHE");
+		if( dir.Length() == 0 ) dir = "fit_cache";
+		if( dir == "none" ) return;
+		gSystem->mkdir(dir.Data(), kTRUE);
+		fFile = dir + "/" + name + ".txt";
+		Load(fEntries);
+	}
+	~JFitCache() { Save(); }
+
+	bool IsEnabled() const { return fFile.Length() > 0; }
+	int GetNHits() const { return fNHits; }
+	int GetNMisses() const { return fNMisses; }
+
+	// Key of a fit of h with the model described by model
+	static TString Key(const TH1* h, const TString& model) {
+		TString config = TString::Format("%s\n%s\nROOT %d\n", model.Data(), h->ClassName(), gROOT->GetVersionInt());
+		TMD5 md5;
+		md5.Update((const UChar_t*)config.Data(), config.Length());
+
+		std::vector<double> values;
+		const TAxis* axes[3] = {h->GetXaxis(), h->GetYaxis(), h->GetZaxis()};
+		for( const TAxis* axis : axes ) {
+			values.push_back(axis->GetNbins());
+			values.push_back(axis->GetXmin());
+			values.push_back(axis->GetXmax());
+			const TArrayD* edges = axis->GetXbins();
+			for( int i = 0; i < edges->GetSize(); i++ ) values.push_back(edges->At(i));
+		}
+		values.push_back(h->GetEntries());
+		for( int bin = 0; bin < h->GetNcells(); bin++ ) {
+			values.push_back(h->GetBinContent(bin));
+			values.push_back(h->GetBinError(bin));
+		}
+		md5.Update((const UChar_t*)values.data(), values.size() * sizeof(double));
+		md5.Final();
+		return TString(md5.AsString());
+	}
+
+	// Cached values of key; counts a hit or a miss
+	bool Get(const TString& key, std::vector<double>& values) {
+		std::map<std::string, std::vector<double>>::const_iterator it = fEntries.find(key.Data());
+		if( it == fEntries.end() ) {
+			fNMisses++;
+			return false;
+		}
+		values = it->second;
+		fNHits++;
+		return true;
+	}
+
+	void Put(const TString& key, const std::vector<double>& values) {
+		if( !IsEnabled() ) return;
+		fEntries[key.Data()] = values;
+		fChanged = true;
+	}
+
+	// TF1 fit of h in [xmin, xmax] as h->Fit(f, option, "", xmin, xmax), or its
+	// cached result: parameters, errors, chi2 and NDF are set on f and, without
+	// option "N", a copy of f replaces the one stored in h. model names the
+	// function behind f (TF1 of compiled code has no formula to hash); its
+	// starting values, limits, option and range are added to the key.
+	// Returns the fit status.
+	int Fit(TH1* h, TF1* f, const char* option, double xmin, double xmax, const char* model) {
+		const int nPar = f->GetNpar();
+		TString config = TString::Format("%s\noption %s range %.17g %.17g\n", model, option, xmin, xmax);
+		for( int i = 0; i < nPar; i++ ) {
+			double lower, upper;
+			f->GetParLimits(i, lower, upper);
+			config += TString::Format("par %d %.17g %.17g %.17g\n", i, f->GetParameter(i), lower, upper);
+		}
+		TString key = IsEnabled() ? Key(h, config) : TString();
+		std::vector<double> values;
+
+		// values: status, chi2, NDF, fit points, parameters, errors
+		if( !IsEnabled() || !Get(key, values) || (int)values.size() != 4 + 2 * nPar ) {
+			int status = h->Fit(f, option, "", xmin, xmax);
+			values.assign(1, status);
+			values.push_back(f->GetChisquare());
+			values.push_back(f->GetNDF());
+			values.push_back(f->GetNumberFitPoints());
+			for( int i = 0; i < nPar; i++ ) values.push_back(f->GetParameter(i));
+			for( int i = 0; i < nPar; i++ ) values.push_back(f->GetParError(i));
+			Put(key, values);
+			return status;
+		}
+
+		f->SetParameters(&values[4]);
+		f->SetParErrors(&values[4 + nPar]);
+		f->SetChisquare(values[1]);
+		f->SetNDF((int)values[2]);
+		f->SetNumberFitPoints((int)values[3]);
+		if( !TString(option).Contains("N", TString::kIgnoreCase) ) {
+			TObject* old = h->GetListOfFunctions()->FindObject(f->GetName());
+			if( old ) {
+				h->GetListOfFunctions()->Remove(old);
+				delete old;
+			}
+			h->GetListOfFunctions()->Add(f->Clone());
+		}
+		return (int)values[0];
+	}
+
+	// Write the cache if it got new entries, together with those other runs added
+	void Save() {
+		if( !IsEnabled() || !fChanged ) return;
+		std::map<std::string, std::vector<double>> entries;
+		Load(entries);
+		for( const auto& entry : fEntries ) entries[entry.first] = entry.second;
+
+		TString tmpFile = TString::Format("%s.%d.tmp", fFile.Data(), gSystem->GetPid());
+		FILE* out = fopen(tmpFile.Data(), "w");
+		if( !out ) {
+			std::cerr << "Warning: cannot write fit cache " << tmpFile << std::endl;
+			return;
+		}
+		for( const auto& entry : entries ) {
+			fprintf(out, "%s %d", entry.first.c_str(), (int)entry.second.size());
+			for( double v : entry.second ) fprintf(out, " %.17g", v);
+			fprintf(out, "\n");
+		}
+		fclose(out);
+		gSystem->Rename(tmpFile.Data(), fFile.Data());
+		fChanged = false;
+	}
+
+	void PrintSummary() const {
+		if( !IsEnabled() ) return;
+		std::cout << "Fit cache " << fFile << ": " << fNHits << " fits reused, " << fNMisses << " fitted" << std::endl;
+	}
+
+private:
+	void Load(std::map<std::string, std::vector<double>>& entries) const {
+		std::ifstream in(fFile.Data());
+		std::string line;
+		while( std::getline(in, line) ) {
+			// strtod also reads back nan and inf
+			char key[64];
+			int n = 0, length = 0;
+			if( sscanf(line.c_str(), "%63s %d%n", key, &n, &length) != 2 || n < 0 ) continue;
+			std::vector<double> values(n);
+			const char* p = line.c_str() + length;
+			bool ok = true;
+			for( int i = 0; i < n && ok; i++ ) {
+				char* end;
+				values[i] = strtod(p, &end);
+				ok = end != p;
+				p = end;
+			}
+			if( ok ) entries[key] = values;
+		}
+	}
+
+	TString fFile;
+	std::map<std::string, std::vector<double>> fEntries;
+	int fNHits, fNMisses;
+	bool fChanged;
+};
+
+#endif
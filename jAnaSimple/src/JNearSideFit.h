@@ -0,0 +1,291 @@
+// $Id: JNearSideFit.h,v 1.0 2026/10/19 djkim Exp $
+////////////////////////////////////////////////////
+/*!
+  \file JNearSideFit.h
+  \brief Near-side 2D Gaussian fit of the correlations with an analytic
+         gradient, and batches of such fits run over threads
+  \author D.J.Kim (University of Jyvaskyla)
+  \email: djkim@jyu.fi
+  \version $Revision: 1.0 $
+  \date $Date: 2026/10/19 $
+
+  The model is GenGaussian2D of z03_ExtractQuantification.C,
+  f = B + A exp(-0.5 ((x-mx)^2/sx^2 + (y-my)^2/sy^2)), fitted with the
+  chi2 of TH1::Fit (bins with the centre inside the window, bins without
+  error left out) and the same parameter limits. On the bin grid the
+  Gaussian is the product of a dEta and a dPhi factor, so one evaluation
+  needs nEta + nPhi exponentials and a multiply-add loop over the bins,
+  and the gradient comes out of the same loop. Starting values are taken
+  from the moments of the window. Every fit owns its chi2 and Minuit2
+  minimiser, so fits of different histograms run in parallel.
+ */
+////////////////////////////////////////////////////
+
+#ifndef JNEARSIDEFIT_H
+#define JNEARSIDEFIT_H
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <TH2.h>
+#include <TString.h>
+#include <TMath.h>
+#include <TROOT.h>
+#include <Math/IFunction.h>
+#include <Minuit2/Minuit2Minimizer.h>
+
+// Parameters, in the order of GenGaussian2D
+enum { kNSAmplitude, kNSMeanEta, kNSSigmaEta, kNSMeanPhi, kNSSigmaPhi, kNSBackground, kNSNPars };
+
+// Near-side window and parameter limits of the fit (the amplitude and
+// background limits scale with the histogram maximum)
+const double kNSEtaMin = -1.0, kNSEtaMax = 1.0;
+const double kNSPhiMin = -TMath::Pi()/2.0, kNSPhiMax = TMath::Pi()/2.0;
+const double kNSMeanMax = 0.5;
+const double kNSSigmaMin = 0.1, kNSSigmaMax = 2.0;
+
+struct JNearSideFitResult {
+	bool valid;
+	double par[kNSNPars];
+	double chi2;
+	int ndf;
+	int nCalls;
+	JNearSideFitResult() : valid(false), chi2(0), ndf(0), nCalls(0) {
+		for( int i = 0; i < kNSNPars; i++ ) par[i] = 0;
+	}
+
+	// Flat form for the fit cache (src/JFitCache.h): valid, chi2, ndf, nCalls, parameters
+	std::vector<double> GetValues() const {
+		std::vector<double> values = {(double)valid, chi2, (double)ndf, (double)nCalls};
+		values.insert(values.end(), par, par + kNSNPars);
+		return values;
+	}
+	bool SetValues(const std::vector<double>& values) {
+		if( values.size() != 4 + kNSNPars ) return false;
+		valid = values[0] != 0;
+		chi2 = values[1];
+		ndf = (int)values[2];
+		nCalls = (int)values[3];
+		for( int i = 0; i < kNSNPars; i++ ) par[i] = values[4 + i];
+		return true;
+	}
+};
+
+// Description of the fit for the cache key; the version is to be raised with
+// any change of the model, the chi2, the starting values or the minimiser
+inline TString JNearSideFitModel() {
+	return TString::Format("JNearSideFit v1 window %.17g %.17g %.17g %.17g mean %.17g sigma %.17g %.17g",
+			kNSEtaMin, kNSEtaMax, kNSPhiMin, kNSPhiMax, kNSMeanMax, kNSSigmaMin, kNSSigmaMax);
+}
+
+// Chi2 of the model over the window of one histogram, with analytic gradient.
+// Keeps scratch arrays, so one object per thread.
+class JNearSideChi2 : public ROOT::Math::IMultiGradFunction {
+public:
+	JNearSideChi2(const TH2* h, double xMin, double xMax, double yMin, double yMax) : fNPoints(0), fBinArea(0) {
+		std::vector<int> binsX, binsY;
+		for( int ix = 1; ix <= h->GetNbinsX(); ix++ ) {
+			double x = h->GetXaxis()->GetBinCenter(ix);
+			if( x < xMin || x > xMax ) continue;
+			fX.push_back(x);
+			binsX.push_back(ix);
+		}
+		for( int iy = 1; iy <= h->GetNbinsY(); iy++ ) {
+			double y = h->GetYaxis()->GetBinCenter(iy);
+			if( y < yMin || y > yMax ) continue;
+			fY.push_back(y);
+			binsY.push_back(iy);
+		}
+		const int nx = fX.size(), ny = fY.size();
+		fValue.assign(nx * ny, 0.0);
+		fWeight.assign(nx * ny, 0.0);
+		for( int ix = 0; ix < nx; ix++ ) {
+			for( int iy = 0; iy < ny; iy++ ) {
+				double error = h->GetBinError(binsX[ix], binsY[iy]);
+				if( error <= 0 ) continue;
+				fValue[ix * ny + iy] = h->GetBinContent(binsX[ix], binsY[iy]);
+				fWeight[ix * ny + iy] = 1.0 / (error * error);
+				fNPoints++;
+			}
+		}
+		if( nx > 0 && ny > 0 ) fBinArea = h->GetXaxis()->GetBinWidth(binsX[0]) * h->GetYaxis()->GetBinWidth(binsY[0]);
+		fGX.resize(nx);
+		fUX.resize(nx);
+		fGY.resize(ny);
+		fUY.resize(ny);
+	}
+
+	unsigned int NDim() const { return kNSNPars; }
+	ROOT::Math::IMultiGenFunction* Clone() const { return new JNearSideChi2(*this); }
+	int GetNPoints() const { return fNPoints; }
+
+	void Gradient(const double* p, double* grad) const { Compute(p, grad); }
+	void FdF(const double* p, double& f, double* grad) const { f = Compute(p, grad); }
+
+	// Starting values: background at the lowest fitted bin, means and widths
+	// from the first and second moments of the excess above it, and the
+	// amplitude of a Gaussian with the integral of the excess
+	void GetStartValues(double* par) const {
+		const int nx = fX.size(), ny = fY.size();
+		double baseline = 0;
+		bool first = true;
+		for( int i = 0; i < nx * ny; i++ ) {
+			if( fWeight[i] <= 0 ) continue;
+			if( first || fValue[i] < baseline ) baseline = fValue[i];
+			first = false;
+		}
+		double sum = 0, sumX = 0, sumX2 = 0, sumY = 0, sumY2 = 0;
+		for( int ix = 0; ix < nx; ix++ ) {
+			for( int iy = 0; iy < ny; iy++ ) {
+				if( fWeight[ix * ny + iy] <= 0 ) continue;
+				double excess = fValue[ix * ny + iy] - baseline;
+				sum += excess;
+				sumX += excess * fX[ix];
+				sumX2 += excess * fX[ix] * fX[ix];
+				sumY += excess * fY[iy];
+				sumY2 += excess * fY[iy] * fY[iy];
+			}
+		}
+		par[kNSBackground] = baseline;
+		par[kNSMeanEta] = par[kNSMeanPhi] = 0;
+		par[kNSSigmaEta] = par[kNSSigmaPhi] = 0.5;
+		par[kNSAmplitude] = 0;
+		if( sum <= 0 ) return;
+		par[kNSMeanEta] = sumX / sum;
+		par[kNSMeanPhi] = sumY / sum;
+		double varX = sumX2 / sum - par[kNSMeanEta] * par[kNSMeanEta];
+		double varY = sumY2 / sum - par[kNSMeanPhi] * par[kNSMeanPhi];
+		if( varX > 0 ) par[kNSSigmaEta] = TMath::Sqrt(varX);
+		if( varY > 0 ) par[kNSSigmaPhi] = TMath::Sqrt(varY);
+		par[kNSAmplitude] = sum * fBinArea / (2.0 * TMath::Pi() * par[kNSSigmaEta] * par[kNSSigmaPhi]);
+	}
+
+private:
+	double DoEval(const double* p) const { return Compute(p, 0); }
+	double DoDerivative(const double* p, unsigned int icoord) const {
+		double grad[kNSNPars];
+		Compute(p, grad);
+		return grad[icoord];
+	}
+
+	// chi2 = sum w (v - f)^2 and, if grad, its derivatives
+	double Compute(const double* p, double* grad) const {
+		const int nx = fX.size(), ny = fY.size();
+		const double amplitude = p[kNSAmplitude], background = p[kNSBackground];
+		// A zero width switches the factor off, as in GenGaussian2D
+		const double invSx = p[kNSSigmaEta] != 0 ? 1.0 / p[kNSSigmaEta] : 0.0;
+		const double invSy = p[kNSSigmaPhi] != 0 ? 1.0 / p[kNSSigmaPhi] : 0.0;
+		for( int ix = 0; ix < nx; ix++ ) {
+			fUX[ix] = (fX[ix] - p[kNSMeanEta]) * invSx;
+			fGX[ix] = TMath::Exp(-0.5 * fUX[ix] * fUX[ix]);
+		}
+		for( int iy = 0; iy < ny; iy++ ) {
+			fUY[iy] = (fY[iy] - p[kNSMeanPhi]) * invSy;
+			fGY[iy] = TMath::Exp(-0.5 * fUY[iy] * fUY[iy]);
+		}
+
+		// Sums of r = w (v - f) times the derivatives of f
+		double chi2 = 0, sumR = 0, sumRG = 0, sumRGu = 0, sumRGu2 = 0, sumRGv = 0, sumRGv2 = 0;
+		const double* gy = fGY.data();
+		const double* uy = fUY.data();
+		for( int ix = 0; ix < nx; ix++ ) {
+			const double* value = &fValue[ix * ny];
+			const double* weight = &fWeight[ix * ny];
+			const double ag = amplitude * fGX[ix];
+			double rowChi2 = 0, rowR = 0, rowRG = 0, rowRGv = 0, rowRGv2 = 0;
+			for( int iy = 0; iy < ny; iy++ ) {
+				const double d = value[iy] - background - ag * gy[iy];
+				const double r = weight[iy] * d;
+				const double rg = r * gy[iy];
+				rowChi2 += r * d;
+				rowR += r;
+				rowRG += rg;
+				rowRGv += rg * uy[iy];
+				rowRGv2 += rg * uy[iy] * uy[iy];
+			}
+			chi2 += rowChi2;
+			sumR += rowR;
+			sumRG += fGX[ix] * rowRG;
+			sumRGu += fGX[ix] * fUX[ix] * rowRG;
+			sumRGu2 += fGX[ix] * fUX[ix] * fUX[ix] * rowRG;
+			sumRGv += fGX[ix] * rowRGv;
+			sumRGv2 += fGX[ix] * rowRGv2;
+		}
+		if( grad ) {
+			grad[kNSAmplitude] = -2.0 * sumRG;
+			grad[kNSMeanEta] = -2.0 * amplitude * sumRGu * invSx;
+			grad[kNSSigmaEta] = -2.0 * amplitude * sumRGu2 * invSx;
+			grad[kNSMeanPhi] = -2.0 * amplitude * sumRGv * invSy;
+			grad[kNSSigmaPhi] = -2.0 * amplitude * sumRGv2 * invSy;
+			grad[kNSBackground] = -2.0 * sumR;
+		}
+		return chi2;
+	}
+
+	std::vector<double> fX, fY;             // bin centres in the window
+	std::vector<double> fValue, fWeight;    // [ix * nY + iy]; weight 1/error^2, 0 = not fitted
+	int fNPoints;
+	double fBinArea;
+	mutable std::vector<double> fGX, fUX, fGY, fUY;   // Gaussian factors and pulls of the evaluation
+};
+
+// Fit one histogram in the near-side window; valid as TFitResult::IsValid
+inline JNearSideFitResult JFitNearSide(const TH2* h) {
+	JNearSideFitResult result;
+	JNearSideChi2 chi2(h, kNSEtaMin, kNSEtaMax, kNSPhiMin, kNSPhiMax);
+	if( chi2.GetNPoints() <= kNSNPars ) return result;
+
+	const double maxVal = h->GetMaximum();
+	const char* names[kNSNPars] = {"Amplitude", "Mean_eta", "Sigma_eta", "Mean_phi", "Sigma_phi", "Background"};
+	const double lower[kNSNPars] = {0, -kNSMeanMax, kNSSigmaMin, -kNSMeanMax, kNSSigmaMin, 0};
+	const double upper[kNSNPars] = {maxVal * 2.0, kNSMeanMax, kNSSigmaMax, kNSMeanMax, kNSSigmaMax, maxVal};
+	double start[kNSNPars];
+	chi2.GetStartValues(start);
+
+	ROOT::Minuit2::Minuit2Minimizer minimizer(ROOT::Minuit2::kMigrad);
+	minimizer.SetPrintLevel(0);
+	minimizer.SetFunction(chi2);
+	for( int i = 0; i < kNSNPars; i++ ) {
+		if( lower[i] < upper[i] ) {
+			double value = TMath::Min(TMath::Max(start[i], lower[i]), upper[i]);
+			double step = value != 0 ? 0.1 * TMath::Abs(value) : 0.01 * (upper[i] - lower[i]);
+			minimizer.SetLimitedVariable(i, names[i], value, step, lower[i], upper[i]);
+		} else {
+			minimizer.SetVariable(i, names[i], start[i], start[i] != 0 ? 0.1 * TMath::Abs(start[i]) : 0.1);
+		}
+	}
+	result.valid = minimizer.Minimize();
+	for( int i = 0; i < kNSNPars; i++ ) result.par[i] = minimizer.X()[i];
+	result.chi2 = minimizer.MinValue();
+	result.ndf = chi2.GetNPoints() - minimizer.NFree();
+	result.nCalls = minimizer.NCalls();
+	return result;
+}
+
+// Fit all histograms with nThreads threads (0 = one per core); the results are
+// in the order of hists whatever the number of threads
+inline void JFitNearSideBatch(const std::vector<const TH2*>& hists, std::vector<JNearSideFitResult>& results,
+		int nThreads) {
+	results.assign(hists.size(), JNearSideFitResult());
+	if( nThreads <= 0 ) nThreads = std::thread::hardware_concurrency();
+	if( nThreads > (int)hists.size() ) nThreads = hists.size();
+
+	// Threads take the next histogram when done, fit times differ a lot
+	std::atomic<size_t> next(0);
+	auto work = [&]() {
+		for( size_t i = next++; i < hists.size(); i = next++ ) {
+			if( hists[i] ) results[i] = JFitNearSide(hists[i]);
+		}
+	};
+	if( nThreads <= 1 ) {
+		work();
+		return;
+	}
+	ROOT::EnableThreadSafety();
+	std::vector<std::thread> workers;
+	for( int i = 0; i < nThreads; i++ ) workers.push_back(std::thread(work));
+	for( auto& w : workers ) w.join();
+}
+
+#endif
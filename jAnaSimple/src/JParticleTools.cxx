@@ -3,23 +3,30 @@
 #include <map>
 #include <iostream>
 #include <vector>
-#include <algorithm> // For std::find
+#include <algorithm> // For std::binary_search
+#include <iterator>  // For std::begin/std::end
 #include <cmath>     // For std::abs
 
-vector<int> CharmPids = {2, 4, 413, 423, 21, 425, 30443, 10411, 2203, 3203, 3103, 415, 2101, 4103, 10421, 435, 4203, 2103, 1103, 4201, 4, 441, 10441, 
-                        100441, 443, 10443, 20443, 100443, 30443, 9000443, 9010443, 9020443, 445, 100445, 9941003, 9940003, 9942003};
-
-vector<int> BottomPids = {5, 511, -511, 521, -521, 5122, -5122, 531, -531, 5132, -5132, 5232, -5232, 1103, 4201, 10511, -10511, 10521, 
-                        513, 523, 10513, 10523, 20513, 20523, 515, 525, 531, 10531, 533, 10533, 20533, 535, 541, 10541, 543, 10543, 
-                        20543, 545, 5122, 5112, 5212, 5222, 5114, 5214, 5224, 5132, 5232, 5312, 5322, 5314, 5324, 5332, 5334, 5142, 
-                        5242, 5412, 5422, 5414, 5424, 5342, 5432, 5434, 5442, 5444, 5512, 5522, 5514, 5524, 5532, 5534, 5542, 5544, 
-                        5554, 5, 511, 521, 10511, 10521, 513, 523, 10513, 10523, 20513, 20523, 515, 525, 531, 10531, 533, 10533, 20533, 
-                        535, 541, 10541, 543, 10543, 20543, 545,
-                        551, 10551, 100551, 110551, 200551, 210551, 553, 10553, 20553, 30553, 100553, 110553, 120553, 130553, 200553, 
-                        210553, 220553, 300553, 9000553,
-                        9010553, 555, 10555, 20555, 100555, 110555, 120555, 200555, 557, 100557,
-                        5122, 5112, 5212, 5222, 5114, 5214, 5224, 5132, 5232, 5312, 5322, 5314, 5324, 5332, 5334, 5142, 5242, 5412, 5422, 5414, 5424, 5324, 5432, 5434,
-                        5442, 5444, 5512, 5522, 5514, 5524, 5532, 5534, 5542, 5544, 5554 };
+// |PDG| codes that mark a bottom or charm ancestor, sorted and without duplicates
+// so that the lookup is a binary search. Bottom is tested first.
+constexpr int kBottomPids[] = {
+    5, 511, 513, 515, 521, 523, 525, 531, 533, 535, 541, 543, 545, 551, 553, 555, 557,
+    1103, 4201, 5112, 5114, 5122, 5132, 5142, 5212, 5214, 5222, 5224, 5232, 5242,
+    5312, 5314, 5322, 5324, 5332, 5334, 5342, 5412, 5414, 5422, 5424, 5432, 5434,
+    5442, 5444, 5512, 5514, 5522, 5524, 5532, 5534, 5542, 5544, 5554,
+    10511, 10513, 10521, 10523, 10531, 10533, 10541, 10543, 10551, 10553, 10555,
+    20513, 20523, 20533, 20543, 20553, 20555, 30553,
+    100551, 100553, 100555, 100557, 110551, 110553, 110555, 120553, 120555, 130553,
+    200551, 200553, 200555, 210551, 210553, 220553, 300553, 9000553, 9010553};
+
+constexpr int kCharmPids[] = {
+    2, 4, 21, 413, 415, 423, 425, 435, 441, 443, 445,
+    1103, 2101, 2103, 2203, 3103, 3203, 4103, 4201, 4203,
+    10411, 10421, 10441, 10443, 20443, 30443, 100441, 100443, 100445,
+    9000443, 9010443, 9020443, 9940003, 9941003, 9942003};
+
+static_assert(std::is_sorted(std::begin(kBottomPids), std::end(kBottomPids)), "kBottomPids must be sorted");
+static_assert(std::is_sorted(std::begin(kCharmPids), std::end(kCharmPids)), "kCharmPids must be sorted");
 
 using namespace std;
 
@@ -33,45 +40,47 @@ enum ParticleLabel {
     ADDITIONAL_LABEL_2 = 4,
 };
 
-int DetermineLabel(Particle particle, const Event& event) {
-    int pid = particle.id();
-    
-    // Check if the particle is a Pion or Kaon (relevant for label determination)
-    if (std::abs(pid) == 211 || std::abs(pid) == 321) {
-        int mom1 = particle.mother1();
-        int mom1pid = event[mom1].id();
-        if (std::abs(mom1pid) == 421) {
-            int cntB=0, cntC=0;
-            // cout<<"Event size: "<<event.size()<<endl;
-            // cout<<"D0 candidate found: "<<pid<<endl;
+// Flavour flags of a single particle
+enum { kFlavourBottom = 1, kFlavourCharm = 2 };
+
+inline int FlavourOf(int pid) {
+    int apid = std::abs(pid);
+    if (std::binary_search(std::begin(kBottomPids), std::end(kBottomPids), apid)) return kFlavourBottom;
+    if (std::binary_search(std::begin(kCharmPids), std::end(kCharmPids), apid)) return kFlavourCharm;
+    return 0;
+}
+
+// Labels every particle of the event once: a pi/K from a D0 is bottom (non-prompt)
+// if any direct mother of the D0 is a bottom hadron/quark, charm if any is charm,
+// otherwise direct. The mother flavour of each D0 is computed only once per event
+// and shared by all its daughters, so the cost is linear in the event size.
+void JParticleTools::LabelParticles() {
+    int n = event.size();
+    fLabels.assign(n, UNDEFINED);
+    fMotherFlavour.assign(n, -1);
+
+    for (int i = 0; i < n; ++i) {
+        int apid = std::abs(event[i].id());
+        if (apid != 211 && apid != 321) continue;
+
+        int mom1 = event[i].mother1();
+        if (std::abs(event[mom1].id()) != 421) continue;
+
+        if (fMotherFlavour[mom1] < 0) {
+            int flags = 0;
             vector<int> momList = event[mom1].motherList();
-            // cout<<"Total mothers for this D0: "<<momList.size()<<endl;
-            for(long unsigned int j=0; j<momList.size(); j++) {
-                int momPid = std::abs(event[j].id());
-                // cout<<momPid<<" ";
-                if(find(BottomPids.begin(), BottomPids.end(), momPid) != BottomPids.end()){
-                    // cout<<"A bottom found!"<<endl;
-                    cntB++;
-                    }
-                else if(find(CharmPids.begin(), CharmPids.end(), momPid) != CharmPids.end()){
-                    // cout<<"A charm found!"<<endl;
-                    cntC++;
-                    }
-                else{
-                    // cout<<"No bottom or charm found!"<<endl;
-                    }
+            for (size_t j = 0; j < momList.size(); j++) {
+                flags |= FlavourOf(event[momList[j]].id());
             }
-            // cout<<endl;
-
-            if(cntB!=0) return BOTTOM_NON_PROMPT;
-            else if(cntC!=0) return CHARM_PROMPT;
-            else return DIRECT_PROMPT;  
+            fMotherFlavour[mom1] = flags;
         }
-        else return UNDEFINED;   
+
+        if (fMotherFlavour[mom1] & kFlavourBottom) fLabels[i] = BOTTOM_NON_PROMPT;
+        else if (fMotherFlavour[mom1] & kFlavourCharm) fLabels[i] = CHARM_PROMPT;
+        else fLabels[i] = DIRECT_PROMPT;
     }
-    else return UNDEFINED;
-                
 }
+
 void JParticleTools::GetParticles() { 
     constexpr float MinPt = 0.2f;
     
@@ -81,13 +90,8 @@ void JParticleTools::GetParticles() {
     NchFT0M = 0;
     NchCMS = 0;
     
-    // Create a map to hold output messages corresponding to each label
-    std::map<int, std::string> labelMessages = {
-        {DIRECT_PROMPT, "****Direct, prompt****"},
-        {CHARM_PROMPT, "****Charm decayed, Prompt****"},
-        {BOTTOM_NON_PROMPT, "****Bottom decayed, nonprompt****"},
-        // Add other labels and messages here as needed
-    };
+    // Ancestry labels for the whole event in one pass
+    LabelParticles();
     
     for (int i = 0; i < event.size(); ++i) {
         if (!event[i].isFinal() || !event[i].isCharged()) {
@@ -123,15 +127,8 @@ void JParticleTools::GetParticles() {
         int stat = event[i].status();
         
 	
-        int label = DetermineLabel(event[i], event);
-
-        // Use the map to print the message for the corresponding label
-        // if (labelMessages.find(label) != labelMessages.end()) {
-		// 	if(CHARM_PROMPT == label|| BOTTOM_NON_PROMPT == label)
-        //     // std::cout << labelMessages[label] << i << " " << px << " " << py << " " << pz << " " << energy << " " << pid << " " << stat <<"\n"; // Print the corresponding message
-        // } else {
-		// 	//std::cout << "****Unknown label****" << i << " " << px << " " << py << " " << pz << " " << energy << " " << pid << " " << stat <<"\n"; // Default message for unknown labels
-		// }
+        int label = fLabels[i];
+
 		new ((*fInputList)[Nch]) JBaseTrack(px, py, pz, energy, pid, label, stat);
         Nch++;
 	}
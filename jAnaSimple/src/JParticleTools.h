@@ -20,6 +20,7 @@
 #include "JBaseTrack.h"
 #include "set"
 #include "map"
+#include <vector>
 
 using namespace std;
 using namespace Pythia8; 
@@ -42,6 +43,8 @@ class JParticleTools {
 		}
 
 		void GetParticles();
+		void LabelParticles();                 // one pass over the event, fills fLabels
+		int GetLabel(int i) const {return fLabels[i];}
 		TClonesArray * GetInputList() const{return fInputList;}
 		TRandom3 *unif;
 		int GetTracks() const {return Nch;};
@@ -62,6 +65,10 @@ class JParticleTools {
 
 		double TrackEtaRange ;
 
+		// Per-event memo of the ancestry labelling, indexed by particle index
+		vector<int> fLabels;                   // ParticleLabel of each particle
+		vector<signed char> fMotherFlavour;    // flavour flags of the direct mothers, -1 = not computed
+
 };
 
 #endif
@@ -0,0 +1,180 @@
+// $Id: JStageTimer.h,v 1.0 2026/10/19 djkim Exp $
+////////////////////////////////////////////////////
+/*!
+  \file JStageTimer.h
+  \brief Scoped stage timers with optional hardware counters
+  \author D.J.Kim (University of Jyvaskyla)
+  \email: djkim@jyu.fi
+  \version $Revision: 1.0 $
+  \date $Date: 2026/10/19 $
+
+  A JStageTimer keeps named stages with their number of calls, real time
+  and, with hardware counters (Linux perf_event_open), CPU cycles and
+  instructions of the process. Code is timed with JStageTimer::Scope
+  objects. A disabled timer (default) costs a scope one flag test and no
+  clock read; with -DJSTAGE_TIMERS_OFF the scopes compile to nothing.
+  While a JTrace is recording, every timed call is also added to it.
+ */
+////////////////////////////////////////////////////
+
+#ifndef JSTAGETIMER_H
+#define JSTAGETIMER_H
+
+#include <chrono>
+#include <vector>
+
+#include "JTrace.h"
+
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+class JStageTimer {
+	public:
+		enum { kCycles, kInstructions, kNHardware };
+
+		struct Stage {
+			const char* name;                           // literal, also used by the trace
+			unsigned long long calls;
+			double realTime;                            // seconds
+			unsigned long long hardware[kNHardware];    // 0 without hardware counters
+		};
+
+		// Start of a timed interval
+		struct Mark {
+			std::chrono::steady_clock::time_point time;
+			unsigned long long hardware[kNHardware];
+		};
+
+		// Times the enclosing block as one call of a stage; elapsed (optional)
+		// is incremented by its real time
+		class Scope {
+			public:
+				Scope( JStageTimer& timer, int stage, double* elapsed = 0 ) :
+					fTimer(timer.IsEnabled() ? &timer : 0), fStage(stage), fElapsed(elapsed) {
+					if( fTimer ) fTimer->Start(fMark);
+				}
+				~Scope() {
+					if( !fTimer ) return;
+					double dt = fTimer->Stop(fStage, fMark);
+					if( fElapsed ) *fElapsed += dt;
+				}
+				Scope( const Scope& ) = delete;
+				Scope& operator=( const Scope& ) = delete;
+
+			private:
+				JStageTimer* fTimer;
+				int fStage;
+				double* fElapsed;
+				Mark fMark;
+		};
+
+		JStageTimer() : fEnabled(false), fGroupFd(-1), fInstructionsFd(-1) {}
+		~JStageTimer() { CloseHardware(); }
+		JStageTimer( const JStageTimer& ) = delete;
+		JStageTimer& operator=( const JStageTimer& ) = delete;
+
+		// Start timing; hardware: also count cycles and instructions.
+		// Returns false if the hardware counters are not available (timing still on).
+		bool Enable( bool hardware ) {
+			fEnabled = true;
+			return !hardware || OpenHardware();
+		}
+
+		bool IsEnabled() const {
+#ifdef JSTAGE_TIMERS_OFF
+			return false;
+#else
+			return fEnabled;
+#endif
+		}
+		bool HasHardware() const { return fGroupFd >= 0; }
+
+		// name must outlive the timer (string literal)
+		int AddStage( const char* name ) {
+			Stage stage = {name, 0, 0.0, {0, 0}};
+			fStages.push_back(stage);
+			return fStages.size() - 1;
+		}
+		const std::vector<Stage>& GetStages() const { return fStages; }
+
+		void Start( Mark& mark ) const {
+			ReadHardware(mark.hardware);
+			mark.time = std::chrono::steady_clock::now();
+		}
+
+		// Add the interval since mark to a stage; returns its real time
+		double Stop( int stage, const Mark& mark ) {
+			std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			unsigned long long hardware[kNHardware];
+			ReadHardware(hardware);
+			Stage& s = fStages[stage];
+			double dt = std::chrono::duration<double>(now - mark.time).count();
+			s.calls++;
+			s.realTime += dt;
+			for( int i = 0; i < kNHardware; i++ ) s.hardware[i] += hardware[i] - mark.hardware[i];
+			if( JTrace::Get().IsActive() ) JTrace::Get().Add(s.name, mark.time, now);
+			return dt;
+		}
+
+	private:
+#ifdef __linux__
+		static int OpenCounter( unsigned long long config, int groupFd ) {
+			perf_event_attr attr;
+			memset(&attr, 0, sizeof(attr));
+			attr.size = sizeof(attr);
+			attr.type = PERF_TYPE_HARDWARE;
+			attr.config = config;
+			attr.disabled = groupFd < 0;   // the group starts with its leader
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.read_format = PERF_FORMAT_GROUP;
+			return syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, 0);
+		}
+
+		bool OpenHardware() {
+			if( fGroupFd >= 0 ) return true;
+			fGroupFd = OpenCounter(PERF_COUNT_HW_CPU_CYCLES, -1);
+			if( fGroupFd < 0 ) return false;
+			fInstructionsFd = OpenCounter(PERF_COUNT_HW_INSTRUCTIONS, fGroupFd);
+			if( fInstructionsFd < 0 ) {
+				CloseHardware();
+				return false;
+			}
+			ioctl(fGroupFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+			ioctl(fGroupFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+			return true;
+		}
+
+		void CloseHardware() {
+			if( fInstructionsFd >= 0 ) close(fInstructionsFd);
+			if( fGroupFd >= 0 ) close(fGroupFd);
+			fGroupFd = fInstructionsFd = -1;
+		}
+
+		void ReadHardware( unsigned long long* values ) const {
+			struct { unsigned long long nr; unsigned long long values[kNHardware]; } group = {0, {0, 0}};
+			if( fGroupFd < 0 || read(fGroupFd, &group, sizeof(group)) != (ssize_t)sizeof(group) ) {
+				values[kCycles] = values[kInstructions] = 0;
+				return;
+			}
+			values[kCycles] = group.values[0];
+			values[kInstructions] = group.values[1];
+		}
+#else
+		bool OpenHardware() { return false; }
+		void CloseHardware() {}
+		void ReadHardware( unsigned long long* values ) const { values[kCycles] = values[kInstructions] = 0; }
+#endif
+
+		bool fEnabled;
+		int fGroupFd;          // cycles, leader of the counter group
+		int fInstructionsFd;
+		std::vector<Stage> fStages;
+};
+
+#endif
@@ -0,0 +1,108 @@
+// $Id: JStreamDataManager_Pythia.cxx,v 1.0 2026/10/19 djkim Exp $
+////////////////////////////////////////////////////
+/*!
+  \file JStreamDataManager_Pythia.cxx
+  \brief Reads clustered Pythia events from the event server (EventServer.C)
+  \author D.J.Kim (University of Jyvaskyla)
+  \email: djkim@jyu.fi
+  \version $Revision: 1.0 $
+  \date $Date: 2026/10/19 $
+ */
+////////////////////////////////////////////////////
+
+#include "JStreamDataManager_Pythia.h"
+
+//______________________________________________________________________________
+JStreamDataManager_Pythia::JStreamDataManager_Pythia():
+	JTreeDataManager_Pythia(),
+	fSocket(-1),
+	fNEvents(0),
+	fNextEvent(0),
+	fBatchPos(0)
+{
+	// constructor
+}
+
+//______________________________________________________________________________
+JStreamDataManager_Pythia::~JStreamDataManager_Pythia(){
+	if( fSocket >= 0 ){
+		RequestEvents(fSocket, 0);  // tell the server we are done
+		close(fSocket);
+	}
+}
+
+//______________________________________________________________________________
+void JStreamDataManager_Pythia::ChainInputStream(const char* streamSpec){
+	// "stream:<socket path>:<number of events>"
+	TString spec(streamSpec);
+	spec.Remove(0, strlen("stream:"));
+	int colon = spec.Last(':');
+	if( colon < 0 ){
+		cout<<"Bad stream input "<<streamSpec<<", expected stream:<socket>:<nEvents>"<<endl;
+		exit(1);   // a job without events must not look successful
+	}
+	TString socketPath = spec(0, colon);
+	fNEvents = TString(spec(colon+1, spec.Length())).Atoi();
+	if( fNEvents <= 0 ){
+		cout<<"Bad stream input "<<streamSpec<<", the number of events must be positive"<<endl;
+		exit(1);
+	}
+
+	fSocket = ConnectEventServer(socketPath.Data());
+	if( fSocket < 0 ){
+		cout<<"Cannot connect to event server at "<<socketPath<<endl;
+		exit(1);
+	}
+	// Ask for everything in one request: the server then generates and sends
+	// batch after batch without waiting for us to ask again
+	RequestEvents(fSocket, fNEvents);
+	cout<<Form("requested %d events from %s\n", fNEvents, socketPath.Data())<<endl;
+
+	weight = 1.0;
+	fHasJetTags = true;  // the server always sends the jet index of each track
+	fHasJetPt = true;
+	fTrackList = new TClonesArray("AliJBaseTrack", 1000);
+}
+
+//______________________________________________________________________________
+int JStreamDataManager_Pythia::LoadEvent(int ievt){
+	// Events can only be read in order
+	fEventLoaded = false;
+	if( ievt != fNextEvent ){
+		cout<<"Stream input: event "<<ievt<<" requested, expected "<<fNextEvent<<endl;
+		return 0;
+	}
+
+	if( fBatchPos >= fBatch.size() ){
+		if( !ReadFrameBatch(fSocket, fBatch, fPayload) || fBatch.empty() ){
+			cout<<"Stream input: server closed or sent a bad frame after "<<fNextEvent<<" of "<<fNEvents<<" events"<<endl;
+			return 0;
+		}
+		fBatchPos = 0;
+	}
+
+	// Copy into the branch variables used by RegisterList()
+	const JEventFrame& ev = fBatch[fBatchPos++];
+	nTracks = ev.nTracks;
+	nJets = ev.nJets;
+	weight = ev.weight;
+	for(int ii = 0; ii < nTracks; ii++){
+		track_px[ii] = ev.track_px[ii];
+		track_py[ii] = ev.track_py[ii];
+		track_pz[ii] = ev.track_pz[ii];
+		track_e[ii] = ev.track_e[ii];
+		track_pt[ii] = ev.track_pt[ii];
+		track_eta[ii] = ev.track_eta[ii];
+		track_phi[ii] = ev.track_phi[ii];
+		track_charge[ii] = ev.track_charge[ii];
+		track_id[ii] = ev.track_id[ii];
+		track_jetIndex[ii] = ev.track_jetIndex[ii];
+	}
+	for(int ij = 0; ij < nJets; ij++){  // ReadFrameBatch checked nJets <= kFrameMaxJets
+		jet_pt[ij] = ev.jet_pt[ij];
+	}
+	fNextEvent++;
+	fEventLoaded = true;
+
+	return 1;
+}
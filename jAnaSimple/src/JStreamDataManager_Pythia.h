@@ -0,0 +1,46 @@
+// $Id: JStreamDataManager_Pythia.h,v 1.0 2026/10/19 djkim Exp $
+////////////////////////////////////////////////////
+/*!
+  \file JStreamDataManager_Pythia.h
+  \brief Reads clustered Pythia events from the event server (EventServer.C)
+  \author D.J.Kim (University of Jyvaskyla)
+  \email: djkim@jyu.fi
+  \version $Revision: 1.0 $
+  \date $Date: 2026/10/19 $
+
+  Drop-in replacement for JTreeDataManager_Pythia: the events are decoded into
+  the same branch variables, so RegisterList() and the getters are unchanged.
+  Input specification: "stream:<socket path>:<number of events>"
+ */
+////////////////////////////////////////////////////
+
+#ifndef JSTREAMDATAMANAGER_PYTHIA_H
+#define JSTREAMDATAMANAGER_PYTHIA_H
+
+#include <vector>
+
+#include "JTreeDataManager_Pythia.h"
+#include "JEventFrame.h"
+
+class JStreamDataManager_Pythia : public JTreeDataManager_Pythia {
+
+	public:
+		JStreamDataManager_Pythia();
+		virtual ~JStreamDataManager_Pythia();
+
+		virtual void ChainInputStream(const char* streamSpec);
+		virtual int LoadEvent( int ievt );
+		virtual int GetNEvents(){ return fNEvents; }
+
+		static bool IsStreamInput(const char* input){ return TString(input).BeginsWith("stream:"); }
+
+	protected:
+		int fSocket;                        // connection to the event server
+		int fNEvents;                       // number of events requested
+		int fNextEvent;                     // next event index expected by LoadEvent
+		size_t fBatchPos;                   // position in the current batch
+		std::vector<JEventFrame> fBatch;    // decoded events of the current batch
+		std::vector<char> fPayload;         // raw batch buffer, reused
+};
+
+#endif
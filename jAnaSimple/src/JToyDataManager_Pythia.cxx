@@ -0,0 +1,81 @@
+// $Id: JToyDataManager_Pythia.cxx,v 1.0 2026/10/19 djkim Exp $
+////////////////////////////////////////////////////
+/*!
+  \file JToyDataManager_Pythia.cxx
+  \brief Synthetic toy events (JToyEventGenerator) in place of Pythia trees
+  \author D.J.Kim (University of Jyvaskyla)
+  \email: djkim@jyu.fi
+  \version $Revision: 1.0 $
+  \date $Date: 2026/10/19 $
+ */
+////////////////////////////////////////////////////
+
+#include "JToyDataManager_Pythia.h"
+
+//______________________________________________________________________________
+JToyDataManager_Pythia::JToyDataManager_Pythia():
+	JTreeDataManager_Pythia(),
+	fNEvents(0)
+{
+	// constructor
+}
+
+//______________________________________________________________________________
+JToyDataManager_Pythia::~JToyDataManager_Pythia(){
+}
+
+//______________________________________________________________________________
+void JToyDataManager_Pythia::ChainInputStream(const char* toySpec){
+	// "toy:<number of events>[:<generator options>]"
+	TString spec(toySpec);
+	spec.Remove(0, strlen("toy:"));
+	int colon = spec.First(':');
+	TString options = colon < 0 ? TString("") : TString(spec(colon+1, spec.Length()));
+	fNEvents = TString(colon < 0 ? spec : TString(spec(0, colon))).Atoi();
+	if( fNEvents <= 0 || !fGenerator.Configure(options.Data()) ){
+		cout<<"Bad toy input "<<toySpec<<", expected toy:<nEvents>[:key=value,...]"<<endl;
+		exit(1);
+	}
+	cout<<Form("there are %d toy events: %s\n", fNEvents, fGenerator.GetDescription().Data())<<endl;
+
+	weight = 1.0;
+	fHasJetTags = true;
+	fHasJetPt = true;
+	fTrackList = new TClonesArray("AliJBaseTrack", 1000);
+}
+
+//______________________________________________________________________________
+int JToyDataManager_Pythia::LoadEvent(int ievt){
+	fEventLoaded = ievt >= 0 && ievt < fNEvents;
+	if( !fEventLoaded ) return 0;
+	fGenerator.Generate(ievt);
+
+	// Jets into the branch variables used by GetNJets()
+	const std::vector<JToyEventGenerator::Jet>& jets = fGenerator.GetJets();
+	nTracks = fGenerator.GetTracks().size();
+	nJets = jets.size();
+	for(int ij = 0; ij < nJets && ij < kFrameMaxJets; ij++){
+		jet_pt[ij] = jets[ij].pt;
+	}
+
+	return 1;
+}
+
+//______________________________________________________________________________
+void JToyDataManager_Pythia::RegisterList(TClonesArray* listToFill, TClonesArray* /*listFromToFill*/){
+	// Same selection as JTreeDataManager_Pythia::RegisterList, without the array limit
+	listToFill->Clear();
+
+	int counter = 0;
+	for(const auto& t : fGenerator.GetTracks()){
+		if(TMath::Abs(t.eta) > 0.8) continue;
+
+		JBaseTrack *track = new ((*listToFill)[counter]) JBaseTrack();
+		track->SetPxPyPzE(t.px, t.py, t.pz, t.e);
+		track->SetID(t.id);
+		track->SetCharge(t.charge);
+		track->SetJetMask(t.jetIndex >= 0 && t.jetIndex < kFrameMaxJets ? 1ULL << t.jetIndex : 0ULL);
+
+		counter++;
+	}
+}
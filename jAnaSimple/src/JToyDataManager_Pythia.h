@@ -0,0 +1,46 @@
+// $Id: JToyDataManager_Pythia.h,v 1.0 2026/10/19 djkim Exp $
+////////////////////////////////////////////////////
+/*!
+  \file JToyDataManager_Pythia.h
+  \brief Synthetic toy events (JToyEventGenerator) in place of Pythia trees
+  \author D.J.Kim (University of Jyvaskyla)
+  \email: djkim@jyu.fi
+  \version $Revision: 1.0 $
+  \date $Date: 2026/10/19 $
+
+  Drop-in replacement for JTreeDataManager_Pythia for tests and benchmarks
+  without Pythia and FastJet. Events are generated on LoadEvent() in any
+  order; RegisterList() reads them directly, so the multiplicity is not
+  limited by the 1000-track arrays of the tree layout.
+  Input specification: "toy:<number of events>[:<generator options>]",
+  e.g. "toy:100000:mult=nbd,mean=300,k=1.5,jets=2,seed=3"
+ */
+////////////////////////////////////////////////////
+
+#ifndef JTOYDATAMANAGER_PYTHIA_H
+#define JTOYDATAMANAGER_PYTHIA_H
+
+#include "JTreeDataManager_Pythia.h"
+#include "JToyEventGenerator.h"
+
+class JToyDataManager_Pythia : public JTreeDataManager_Pythia {
+
+	public:
+		JToyDataManager_Pythia();
+		virtual ~JToyDataManager_Pythia();
+
+		virtual void ChainInputStream(const char* toySpec);
+		virtual int LoadEvent( int ievt );
+		virtual void RegisterList(TClonesArray* listToFill, TClonesArray* listFromToFill);
+		virtual int GetNEvents(){ return fNEvents; }
+
+		JToyEventGenerator& GetGenerator(){ return fGenerator; }
+
+		static bool IsToyInput(const char* input){ return TString(input).BeginsWith("toy:"); }
+
+	protected:
+		int fNEvents;                       // number of events of the sample
+		JToyEventGenerator fGenerator;      // holds the current event
+};
+
+#endif
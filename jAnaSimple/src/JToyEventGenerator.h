@@ -0,0 +1,276 @@
+// $Id: JToyEventGenerator.h,v 1.0 2026/10/19 djkim Exp $
+////////////////////////////////////////////////////
+/*!
+  \file JToyEventGenerator.h
+  \brief Synthetic events with a chosen multiplicity distribution and jet-like clusters
+  \author D.J.Kim (University of Jyvaskyla)
+  \email: djkim@jyu.fi
+  \version $Revision: 1.0 $
+  \date $Date: 2026/10/19 $
+
+  Needs neither Pythia nor FastJet. An event is an underlying event of
+  uncorrelated tracks plus nJets clusters of tracks around a jet axis
+  (back-to-back pairs by default), each cluster tagged as one jet with the
+  summed four-momentum of its tracks. Event i only depends on the seed and
+  i, so events can be generated in any order and split over shards.
+
+  Options "key=value,key=value,..." (defaults in brackets):
+    mult     underlying-event multiplicity: fixed, poisson, nbd, flat [nbd]
+    mean     mean multiplicity (fixed: the multiplicity) [50]
+    k        NBD shape parameter [2]
+    min,max  range of the flat distribution [0,100]
+    slope    track pT above ptmin, exponential slope in GeV/c [0.5]
+    ptmin    minimum track pT in GeV/c [0.2]
+    etamax   maximum track and jet-axis |eta| [0.8]
+    jets     jets per event, at most kFrameMaxJets [2]
+    dijet    1: jets in back-to-back pairs, 0: independent axes [1]
+    jetptmin, jetptmax, jetpower : jet pT ~ pT^-jetpower in [jetptmin, jetptmax] [10, 100, 5]
+    jetconst mean number of tracks per jet (Poisson, at least 1) [8]
+    jetwidth Gaussian spread of the jet tracks in eta and phi [0.1]
+    seed     random seed [1]
+  Track ids are the index in the event (unique, as the engine expects).
+  Multiplicities are not limited; FillFrame() keeps the first
+  kFrameMaxTracks tracks (jet tracks first), the limit of the tree layout.
+ */
+////////////////////////////////////////////////////
+
+#ifndef JTOYEVENTGENERATOR_H
+#define JTOYEVENTGENERATOR_H
+
+#include <iostream>
+#include <vector>
+
+#include <TMath.h>
+#include <TObjArray.h>
+#include <TObjString.h>
+#include <TRandom3.h>
+#include <TString.h>
+
+#include "JEventFrame.h"
+
+class JToyEventGenerator {
+	public:
+		enum { kMultFixed, kMultPoisson, kMultNBD, kMultFlat };
+
+		struct Track {
+			float px, py, pz, e, pt, eta, phi;
+			int charge;
+			int id;                 // index in the event, unique like the Pythia index of z01
+			int pdg;                // charged pion
+			signed char jetIndex;   // -1 = underlying event
+		};
+		struct Jet {
+			float px, py, pz, e, pt, eta, phi;
+			int nConstituents;
+		};
+
+		JToyEventGenerator() :
+			fMultShape(kMultNBD), fMultMean(50), fNBDK(2), fMultMin(0), fMultMax(100),
+			fPtSlope(0.5), fPtMin(0.2), fEtaMax(0.8),
+			fNJets(2), fDijets(true), fJetPtMin(10), fJetPtMax(100), fJetPtPower(5),
+			fJetConst(8), fJetWidth(0.1), fSeed(1) {}
+
+		// Parse "key=value,..." (see above); false on an unknown key or bad value
+		bool Configure( const char* options ) {
+			TObjArray* list = TString(options).Tokenize(",");
+			bool ok = true;
+			for( int i = 0; i < list->GetEntries(); i++ ) {
+				TString opt = ((TObjString*)list->At(i))->GetString();
+				opt = opt.Strip(TString::kBoth);
+				int eq = opt.Index("=");
+				if( opt.Length() == 0 ) continue;
+				TString key = eq < 0 ? opt : TString(opt(0, eq));
+				TString value = eq < 0 ? TString("") : TString(opt(eq+1, opt.Length()));
+				key.ToLower();
+				if( key == "mult" ) {
+					value.ToLower();
+					if( value == "fixed" ) fMultShape = kMultFixed;
+					else if( value == "poisson" ) fMultShape = kMultPoisson;
+					else if( value == "nbd" ) fMultShape = kMultNBD;
+					else if( value == "flat" ) fMultShape = kMultFlat;
+					else { std::cerr << "Toy events: unknown multiplicity distribution " << value << std::endl; ok = false; }
+				}
+				else if( key == "mean" ) fMultMean = value.Atof();
+				else if( key == "k" ) fNBDK = value.Atof();
+				else if( key == "min" ) fMultMin = value.Atoi();
+				else if( key == "max" ) fMultMax = value.Atoi();
+				else if( key == "slope" ) fPtSlope = value.Atof();
+				else if( key == "ptmin" ) fPtMin = value.Atof();
+				else if( key == "etamax" ) fEtaMax = value.Atof();
+				else if( key == "jets" ) fNJets = value.Atoi();
+				else if( key == "dijet" ) fDijets = value.Atoi() != 0;
+				else if( key == "jetptmin" ) fJetPtMin = value.Atof();
+				else if( key == "jetptmax" ) fJetPtMax = value.Atof();
+				else if( key == "jetpower" ) fJetPtPower = value.Atof();
+				else if( key == "jetconst" ) fJetConst = value.Atof();
+				else if( key == "jetwidth" ) fJetWidth = value.Atof();
+				else if( key == "seed" ) fSeed = value.Atoi();
+				else { std::cerr << "Toy events: unknown option " << opt << std::endl; ok = false; }
+			}
+			delete list;
+
+			if( fNJets < 0 || fNJets > kFrameMaxJets ) {
+				std::cerr << "Toy events: jets must be in [0, " << kFrameMaxJets << "]" << std::endl;
+				ok = false;
+			}
+			if( fMultMean < 0 || fNBDK <= 0 || fMultMin < 0 || fMultMax < fMultMin || fPtSlope <= 0 || fEtaMax <= 0 ||
+				fJetPtMin <= 0 || fJetPtMax < fJetPtMin || fJetPtPower == 1 || fJetConst < 0 || fJetWidth < 0 ) {
+				std::cerr << "Toy events: bad parameter in \"" << options << "\"" << std::endl;
+				ok = false;
+			}
+			return ok;
+		}
+
+		// One line summary of the configuration
+		TString GetDescription() const {
+			static const char* shapes[] = {"fixed", "poisson", "nbd", "flat"};
+			TString mult = fMultShape == kMultFlat ? TString::Format("flat %d-%d", fMultMin, fMultMax)
+				: TString::Format("%s mean %g", shapes[fMultShape], fMultMean);
+			if( fMultShape == kMultNBD ) mult += TString::Format(" k %g", fNBDK);
+			return TString::Format("multiplicity %s, %d %sjets of %g-%g GeV/c with %g tracks, seed %u",
+					mult.Data(), fNJets, fDijets ? "back-to-back " : "", fJetPtMin, fJetPtMax, fJetConst, fSeed);
+		}
+
+		// Generate event ievt of the sample
+		void Generate( long ievt ) {
+			fRandom.SetSeed((UInt_t)(fSeed * 2654435761u + ievt + 1));   // 0 would mean a time seed
+			fTracks.clear();
+			fJets.clear();
+
+			// Jets first: truncation to the tree layout drops underlying-event tracks
+			double axisPhi = 0, axisPt = 0;
+			for( int ij = 0; ij < fNJets; ij++ ) {
+				double pt, phi;
+				if( fDijets && ij % 2 == 1 ) {
+					pt = axisPt * fRandom.Uniform(0.6, 1.0);   // recoil jet, imbalanced
+					phi = axisPhi + TMath::Pi() + fRandom.Gaus(0, fJetWidth);
+				} else {
+					pt = GetJetPt();
+					phi = fRandom.Uniform(-TMath::Pi(), TMath::Pi());
+				}
+				axisPt = pt;
+				axisPhi = phi;
+				AddJet(ij, pt, fRandom.Uniform(-fEtaMax, fEtaMax), phi);
+			}
+
+			const int nUE = GetMultiplicity();
+			for( int it = 0; it < nUE; it++ ) {
+				AddTrack(fPtMin + fRandom.Exp(fPtSlope), fRandom.Uniform(-fEtaMax, fEtaMax),
+						fRandom.Uniform(-TMath::Pi(), TMath::Pi()), -1);
+			}
+		}
+
+		const std::vector<Track>& GetTracks() const { return fTracks; }
+		const std::vector<Jet>& GetJets() const { return fJets; }
+
+		// Copy the current event into the tree/stream record; returns the number of dropped tracks
+		int FillFrame( JEventFrame& ev, int eventID ) const {
+			ev.Clear();
+			ev.eventID = eventID;
+			ev.nTracks = TMath::Min((int)fTracks.size(), kFrameMaxTracks);
+			ev.nJets = fJets.size();
+			for( int it = 0; it < ev.nTracks; it++ ) {
+				const Track& t = fTracks[it];
+				ev.track_px[it] = t.px; ev.track_py[it] = t.py; ev.track_pz[it] = t.pz; ev.track_e[it] = t.e;
+				ev.track_pt[it] = t.pt; ev.track_eta[it] = t.eta; ev.track_phi[it] = t.phi;
+				ev.track_charge[it] = t.charge; ev.track_id[it] = t.id;
+				ev.track_jetIndex[it] = t.jetIndex;
+			}
+			for( int ij = 0; ij < ev.nJets; ij++ ) {
+				const Jet& j = fJets[ij];
+				ev.jet_px[ij] = j.px; ev.jet_py[ij] = j.py; ev.jet_pz[ij] = j.pz; ev.jet_e[ij] = j.e;
+				ev.jet_pt[ij] = j.pt; ev.jet_eta[ij] = j.eta; ev.jet_phi[ij] = j.phi;
+				ev.jet_nConstituents[ij] = j.nConstituents;
+			}
+			return fTracks.size() - ev.nTracks;
+		}
+
+	private:
+		int GetMultiplicity() {
+			switch( fMultShape ) {
+				case kMultFixed:   return TMath::Nint(fMultMean);
+				case kMultPoisson: return fRandom.Poisson(fMultMean);
+				case kMultNBD:     return fRandom.Poisson(GetGamma(fNBDK) * fMultMean / fNBDK);   // Gamma-Poisson mixture
+				default:           return fRandom.Integer(fMultMax - fMultMin + 1) + fMultMin;
+			}
+		}
+
+		// Gamma(k, 1) (Marsaglia-Tsang)
+		double GetGamma( double k ) {
+			if( k < 1 ) return GetGamma(k + 1) * TMath::Power(fRandom.Rndm(), 1.0 / k);
+			const double d = k - 1.0 / 3.0;
+			const double c = 1.0 / TMath::Sqrt(9.0 * d);
+			while( true ) {
+				double x = fRandom.Gaus();
+				double v = 1 + c * x;
+				if( v <= 0 ) continue;
+				v = v * v * v;
+				if( TMath::Log(fRandom.Rndm()) < 0.5 * x * x + d - d * v + d * TMath::Log(v) ) return d * v;
+			}
+		}
+
+		// Power law pT^-n between fJetPtMin and fJetPtMax (inverse CDF)
+		double GetJetPt() {
+			const double a = 1 - fJetPtPower;
+			const double lo = TMath::Power(fJetPtMin, a);
+			const double hi = TMath::Power(fJetPtMax, a);
+			return TMath::Power(lo + fRandom.Rndm() * (hi - lo), 1.0 / a);
+		}
+
+		// Tracks share the jet pT with exponential fractions around the axis
+		void AddJet( int index, double pt, double eta, double phi ) {
+			const int n = TMath::Max(1, fRandom.Poisson(fJetConst));
+			fFractions.resize(n);
+			double sum = 0;
+			for( int i = 0; i < n; i++ ) sum += (fFractions[i] = fRandom.Exp(1.0));
+			Jet jet = {0, 0, 0, 0, 0, 0, 0, n};
+			for( int i = 0; i < n; i++ ) {
+				const Track& t = AddTrack(pt * fFractions[i] / sum, eta + fRandom.Gaus(0, fJetWidth),
+						phi + fRandom.Gaus(0, fJetWidth), index);
+				jet.px += t.px; jet.py += t.py; jet.pz += t.pz; jet.e += t.e;
+			}
+			jet.pt = TMath::Sqrt(jet.px * jet.px + jet.py * jet.py);
+			jet.eta = TMath::ASinH(jet.pz / jet.pt);
+			jet.phi = TMath::ATan2(jet.py, jet.px);
+			fJets.push_back(jet);
+		}
+
+		const Track& AddTrack( double pt, double eta, double phi, int jetIndex ) {
+			const double kPionMass = 0.13957;
+			Track t;
+			t.px = pt * TMath::Cos(phi);
+			t.py = pt * TMath::Sin(phi);
+			t.pz = pt * TMath::SinH(eta);
+			t.e = TMath::Sqrt(t.px * t.px + t.py * t.py + t.pz * t.pz + kPionMass * kPionMass);
+			t.pt = pt;
+			t.eta = eta;
+			t.phi = TMath::ATan2(t.py, t.px);
+			t.charge = fRandom.Rndm() < 0.5 ? -1 : 1;
+			t.id = fTracks.size();   // the engine pairs tracks with different ids only
+			t.pdg = 211 * t.charge;
+			t.jetIndex = jetIndex;
+			fTracks.push_back(t);
+			return fTracks.back();
+		}
+
+		int fMultShape;
+		double fMultMean;
+		double fNBDK;
+		int fMultMin, fMultMax;
+		double fPtSlope;
+		double fPtMin;
+		double fEtaMax;
+		int fNJets;
+		bool fDijets;
+		double fJetPtMin, fJetPtMax, fJetPtPower;
+		double fJetConst;
+		double fJetWidth;
+		unsigned int fSeed;
+
+		TRandom3 fRandom;
+		std::vector<Track> fTracks;
+		std::vector<Jet> fJets;
+		std::vector<double> fFractions;   // jet pT fractions, reused
+};
+
+#endif
@@ -0,0 +1,154 @@
+// $Id: JTrace.h,v 1.0 2026/10/19 djkim Exp $
+////////////////////////////////////////////////////
+/*!
+  \file JTrace.h
+  \brief Timeline of stages per thread in the Chrome trace-event format
+  \author D.J.Kim (University of Jyvaskyla)
+  \email: djkim@jyu.fi
+  \version $Revision: 1.0 $
+  \date $Date: 2026/10/19 $
+
+  JTrace::Get() is the process-wide recorder. Once started, every
+  JTraceScope (and every enabled JStageTimer::Scope) adds a complete event
+  (begin, duration) with the thread and the current chunk (input file,
+  shard, pT-hat slice). Each thread writes to its own buffer, so recording
+  takes no lock. Write() stores the events as JSON for chrome://tracing or
+  ui.perfetto.dev. At most kMaxEvents are kept; later ones are counted only.
+ */
+////////////////////////////////////////////////////
+
+#ifndef JTRACE_H
+#define JTRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+class JTrace {
+	public:
+		typedef std::chrono::steady_clock::time_point TimePoint;
+
+		static const long kMaxEvents = 2000000;   // about 250 MB of JSON
+
+		static JTrace& Get() {
+			static JTrace trace;
+			return trace;
+		}
+
+		// Start recording; process: name shown for this process in the viewer
+		void Start( const char* fileName, const char* process ) {
+			fFileName = fileName;
+			fProcess = process;
+			fStart = std::chrono::steady_clock::now();
+			fActive.store(true, std::memory_order_release);
+		}
+		bool IsActive() const { return fActive.load(std::memory_order_relaxed); }
+
+		// Name of the calling thread and the chunk of work it is on (-1 = none)
+		void SetThreadName( const char* name ) { if( IsActive() ) GetBuffer().name = name; }
+		void SetChunk( long chunk ) { if( IsActive() ) GetBuffer().chunk = chunk; }
+
+		// Complete event of the calling thread; name must outlive the trace (literal)
+		void Add( const char* name, TimePoint begin, TimePoint end ) {
+			if( fNEvents.fetch_add(1, std::memory_order_relaxed) >= kMaxEvents ) return;
+			Buffer& buffer = GetBuffer();
+			Event event = {name, buffer.chunk, Micro(begin), Micro(end) - Micro(begin)};
+			buffer.events.push_back(event);
+		}
+
+		// Write all events (call after the worker threads are joined); false on error
+		bool Write() {
+			if( !IsActive() ) return true;
+			fActive.store(false, std::memory_order_release);
+			FILE* out = fopen(fFileName.c_str(), "w");
+			if( !out ) return false;
+			const int pid = getpid();
+			fprintf(out, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+			fprintf(out, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":0,\"args\":{\"name\":\"%s\"}}",
+					pid, fProcess.c_str());
+			std::lock_guard<std::mutex> lock(fMutex);
+			for( size_t tid = 0; tid < fBuffers.size(); tid++ ) {
+				const Buffer& buffer = *fBuffers[tid];
+				fprintf(out, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%zu,\"args\":{\"name\":\"%s\"}}",
+						pid, tid, buffer.name.c_str());
+				for( const auto& event : buffer.events ) {
+					fprintf(out, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%zu",
+							event.name, fProcess.c_str(), event.begin, event.duration, pid, tid);
+					if( event.chunk >= 0 ) fprintf(out, ",\"args\":{\"chunk\":%ld}", event.chunk);
+					fprintf(out, "}");
+				}
+			}
+			fprintf(out, "\n]}\n");
+			bool ok = ferror(out) == 0;
+			ok = fclose(out) == 0 && ok;
+			return ok;
+		}
+
+		long GetNEvents() const { return fNEvents.load(); }
+		long GetNDropped() const { return fNEvents.load() > kMaxEvents ? fNEvents.load() - kMaxEvents : 0; }
+
+	private:
+		struct Event {
+			const char* name;
+			long chunk;
+			double begin;      // us since Start
+			double duration;   // us
+		};
+		struct Buffer {
+			std::string name;
+			long chunk;
+			std::vector<Event> events;
+		};
+
+		JTrace() : fActive(false), fNEvents(0) {}
+
+		double Micro( TimePoint t ) const { return std::chrono::duration<double, std::micro>(t - fStart).count(); }
+
+		// Buffer of the calling thread, registered on its first use
+		Buffer& GetBuffer() {
+			thread_local Buffer* buffer = 0;
+			if( !buffer ) {
+				std::lock_guard<std::mutex> lock(fMutex);
+				fBuffers.emplace_back(new Buffer());
+				buffer = fBuffers.back().get();
+				buffer->name = fBuffers.size() == 1 ? "main" : "thread " + std::to_string(fBuffers.size() - 1);
+				buffer->chunk = -1;
+			}
+			return *buffer;
+		}
+
+		std::atomic<bool> fActive;
+		std::atomic<long> fNEvents;
+		std::string fFileName;
+		std::string fProcess;
+		TimePoint fStart;
+		std::mutex fMutex;
+		std::vector<std::unique_ptr<Buffer>> fBuffers;   // index = tid in the trace
+};
+
+// Records the enclosing block (or the part up to Stop) as one event while the trace is active
+class JTraceScope {
+	public:
+		JTraceScope( const char* name ) : fName(JTrace::Get().IsActive() ? name : 0) {
+			if( fName ) fBegin = std::chrono::steady_clock::now();
+		}
+		~JTraceScope() { Stop(); }
+		void Stop() {
+			if( fName ) JTrace::Get().Add(fName, fBegin, std::chrono::steady_clock::now());
+			fName = 0;
+		}
+		JTraceScope( const JTraceScope& ) = delete;
+		JTraceScope& operator=( const JTraceScope& ) = delete;
+
+	private:
+		const char* fName;
+		JTrace::TimePoint fBegin;
+};
+
+#endif
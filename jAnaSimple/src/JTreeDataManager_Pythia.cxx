@@ -17,7 +17,12 @@ JTreeDataManager_Pythia::JTreeDataManager_Pythia():
 	fChain(NULL),
 	fTrackList(NULL),
 	fEventHeader(NULL),
-	fEventHeaderList(NULL)
+	fEventHeaderList(NULL),
+	weight(1.0),
+	fHasWeights(false),
+	fHasJetTags(false),
+	fHasJetPt(false),
+	fEventLoaded(false)
 {
 	// constructor
 	// Use simple "events" tree instead of O2Physics "JCIaa/jTree"
@@ -38,7 +43,18 @@ JTreeDataManager_Pythia::~JTreeDataManager_Pythia(){
 
 //______________________________________________________________________________
 bool JTreeDataManager_Pythia::IsGoodEvent(){
-	return true;
+	// After a failed read the branch variables still hold the previous event
+	return fEventLoaded;
+}
+
+//______________________________________________________________________________
+int JTreeDataManager_Pythia::GetNJets(float ptMin) const {
+	if( ptMin <= 0 || !fHasJetPt ) return nJets;
+	int n = 0;
+	for(int ij = 0; ij < nJets && ij < kFrameMaxJets; ij++){
+		if( jet_pt[ij] >= ptMin ) n++;
+	}
+	return n;
 }
 
 //______________________________________________________________________________
@@ -48,7 +64,7 @@ void JTreeDataManager_Pythia::RegisterList(TClonesArray* listToFill, TClonesArra
 	listToFill->Clear();
 
 	int counter = 0;
-	for(int ii = 0; ii < nTracks && ii < 1000; ii++) {
+	for(int ii = 0; ii < nTracks && ii < kFrameMaxTracks; ii++) {
 		// Apply eta cut (same as used in event generation)
 		if(TMath::Abs(track_eta[ii]) > 0.8) continue;
 
@@ -57,6 +73,9 @@ void JTreeDataManager_Pythia::RegisterList(TClonesArray* listToFill, TClonesArra
 		track->SetPxPyPzE(track_px[ii], track_py[ii], track_pz[ii], track_e[ii]);
 		track->SetID(track_id[ii]);
 		track->SetCharge(track_charge[ii]);
+		// Jet membership as a bit mask: bit j = constituent of jet j
+		int ij = track_jetIndex[ii];
+		track->SetJetMask(ij >= 0 && ij < kFrameMaxJets ? 1ULL << ij : 0ULL);
 
 		counter++;
 	}
@@ -90,6 +109,30 @@ void JTreeDataManager_Pythia::ChainInputStream(const char* infileList){
 	fChain->SetBranchAddress("track_charge", track_charge);
 	fChain->SetBranchAddress("track_id", track_id);
 
+	// Weight branch only exists in pT-hat sliced samples; older files stay unweighted.
+	// Files whose weights are all 1 (unsliced z01 output before the branch became
+	// optional, toy events) are read as unweighted too: one pass over the branch
+	// saves Sumw2 on every histogram.
+	if( fChain->GetBranch("weight") && (fChain->GetMinimum("weight") != 1 || fChain->GetMaximum("weight") != 1) ){
+		fChain->SetBranchAddress("weight", &weight);
+		fHasWeights = true;
+		cout<<"Using per-event weights from \"weight\" branch"<<endl;
+	}
+
+	// Jet membership only exists in newer samples; without it all tracks count as UE
+	memset(track_jetIndex, -1, sizeof(track_jetIndex));
+	if( fChain->GetBranch("track_jetIndex") ){
+		fChain->SetBranchAddress("track_jetIndex", track_jetIndex);
+		fHasJetTags = true;
+		cout<<"Using per-track jet membership from \"track_jetIndex\" branch"<<endl;
+	}
+
+	// Jet pT for jet-pT thresholds in the categorisation
+	if( fChain->GetBranch("jet_pt") ){
+		fChain->SetBranchAddress("jet_pt", jet_pt);
+		fHasJetPt = true;
+	}
+
 	// Allocate TClonesArray for compatibility
 	fTrackList = new TClonesArray("AliJBaseTrack", 1000);
 }
@@ -99,6 +142,7 @@ int JTreeDataManager_Pythia::LoadEvent(int ievt){
 	//clear clones array and counters
 	//load the new event
 	int v = ((TTree*)fChain)->GetEntry(ievt);
+	fEventLoaded = v > 0;
 
 	return v;
 }
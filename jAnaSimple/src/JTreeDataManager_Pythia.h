@@ -17,6 +17,7 @@
 #include <fstream>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 #ifndef ROOT_TObject
 #include <TObject.h>
@@ -33,6 +34,7 @@
 
 #include "JBaseTrack.h"
 #include "JBaseEventHeader.h"
+#include "JEventFrame.h"
 
 class JTreeDataManager_Pythia  {
 
@@ -40,17 +42,21 @@ class JTreeDataManager_Pythia  {
 		JTreeDataManager_Pythia();
 		virtual ~JTreeDataManager_Pythia();		                    //destructor
 
-		void ChainInputStream(const char* infileList);
-		int LoadEvent( int ievt );
+		virtual void ChainInputStream(const char* infileList);
+		virtual int LoadEvent( int ievt );
 		virtual void RegisterList(TClonesArray* listToFill, TClonesArray* listFromToFill);
-		virtual bool IsGoodEvent();
+		virtual bool IsGoodEvent();                      // false if the last LoadEvent failed
 
 		// GETTER
 		TChain * GetChain(){ return fChain; };
-		int GetNEvents(){ return fChain->GetEntries(); }
+		virtual int GetNEvents(){ return fChain->GetEntries(); }
 		JBaseEventHeader * GetEventHeader(){ return fEventHeader; };
 		TClonesArray  *GetEventHeaderList(){ return fEventHeaderList; };
 		int GetNJets() const { return nJets; };
+		int GetNJets( float ptMin ) const;               // jets with pT >= ptMin (all jets for ptMin <= 0)
+		float GetWeight() const { return weight; };      // per-event cross-section weight (1 if unweighted)
+		bool HasWeights() const { return fHasWeights; };
+		bool HasJetTags() const { return fHasJetTags; };  // per-track jet index available
 
 	protected:
 		TChain * fChain;
@@ -61,9 +67,16 @@ class JTreeDataManager_Pythia  {
 		// Branch variables for standalone Pythia tree
 		int nTracks;
 		int nJets;  // Number of jets in the event
-		float track_px[1000], track_py[1000], track_pz[1000], track_e[1000];
-		float track_pt[1000], track_eta[1000], track_phi[1000];
-		int track_charge[1000], track_id[1000];
+		float weight;  // Event weight from pT-hat sliced generation
+		bool fHasWeights;
+		float track_px[kFrameMaxTracks], track_py[kFrameMaxTracks], track_pz[kFrameMaxTracks], track_e[kFrameMaxTracks];
+		float track_pt[kFrameMaxTracks], track_eta[kFrameMaxTracks], track_phi[kFrameMaxTracks];
+		int track_charge[kFrameMaxTracks], track_id[kFrameMaxTracks];
+		Char_t track_jetIndex[kFrameMaxTracks];  // jet the track belongs to, -1 = underlying event
+		bool fHasJetTags;
+		float jet_pt[kFrameMaxJets];
+		bool fHasJetPt;
+		bool fEventLoaded;  // the branch variables hold the event of the last LoadEvent
 };
 
 #endif
@@ -0,0 +1,78 @@
+#!/bin/bash
+# Start the warm event-generation server (EventServer.C) with a minimal ROOT setup
+# Usage: ./run_event_server.sh [socketPath] [nWorkers] [jetR] [pTHatMin] [batchSize] [eCM]
+# Clients:
+#   SimpleCorrelation "stream:<socketPath>:<nEvents>" output.root
+#     (defaults: the z01 sample, 5.36 TeV, pTHatMin 3)
+#   root -l 'draw_jet_pythia.C("<socketPath>")'
+#     (same sample as its local generation: ./run_event_server.sh <socketPath> 2 0.4 20 100 13000)
+
+# Check if ALICE environment is loaded
+if [ -z "$PYTHIA8" ] || [ -z "$FASTJET" ]; then
+    echo "Error: PYTHIA8 or FASTJET not set!"
+    echo "Please run: alienv enter O2Physics/latest-master-o2"
+    exit 1
+fi
+
+# Get arguments or use defaults
+socketPath=${1:-/tmp/draw_jet_events.sock}
+nWorkers=${2:-2}
+jetR=${3:-0.4}
+pTHatMin=${4:-3.0}
+batchSize=${5:-100}
+eCM=${6:-5360}
+
+echo "========================================"
+echo "Pythia Event Server"
+echo "========================================"
+echo "PYTHIA8: $PYTHIA8"
+echo "FASTJET: $FASTJET"
+echo "Socket: $socketPath"
+echo "Workers: $nWorkers"
+echo ""
+
+# Run with minimal ROOT setup
+# Use here-doc without quotes to allow variable expansion
+root -b -n <<EOF
+// Disable autoloading immediately
+gInterpreter->SetClassAutoloading(false);
+gInterpreter->SetClassAutoloading(false);  // Call twice
+
+cout << "Loading libraries explicitly..." << endl;
+
+// Load ROOT libraries first
+gSystem->Load("libTree");
+gSystem->Load("libPhysics");
+cout << "✓ ROOT libraries loaded" << endl;
+
+// Load Pythia8
+TString pythia8Path = gSystem->Getenv("PYTHIA8");
+if(pythia8Path.Length() > 0) {
+  TString pythiaLib = pythia8Path + "/lib/libpythia8";
+  int result = gSystem->Load(pythiaLib);
+  if(result >= 0) {
+    cout << "✓ Pythia 8 loaded" << endl;
+  } else {
+    cerr << "✗ Error loading Pythia 8" << endl;
+    exit(1);
+  }
+}
+
+// Load FastJet
+TString fastjetPath = gSystem->Getenv("FASTJET");
+if(fastjetPath.Length() > 0) {
+  TString fastjetLib = fastjetPath + "/lib/libfastjet";
+  int result = gSystem->Load(fastjetLib);
+  if(result >= 0) {
+    cout << "✓ FastJet loaded" << endl;
+  } else {
+    cerr << "✗ Error loading FastJet" << endl;
+    exit(1);
+  }
+}
+
+cout << "\nCompiling server (ACLiC)..." << endl;
+.L EventServer.C+
+
+RunEventServer("$socketPath", $nWorkers, $jetR, $pTHatMin, $batchSize, $eCM);
+EOF
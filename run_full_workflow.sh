@@ -1,107 +1,236 @@
 #!/bin/bash
 # Complete workflow for Pythia jet correlation analysis
-# Usage: alienv setenv O2Physics/latest -c ./run_full_workflow.sh [nEvents]
-
-set -e  # Exit on error
+# Usage: alienv setenv O2Physics/latest -c ./run_full_workflow.sh [nEvents] [nShards] [jobs]
+#   nEvents : total number of events (default 1000000), split evenly over the shards
+#   nShards : independent generation + correlation shards (default 4)
+#   jobs    : shards running at the same time (default: number of cores)
+# Environment:
+#   PTHAT_BINS       : pT-hat slice edges for the generation, e.g. "3,8,16,32,-1"
+#   ANALYSIS_OPTIONS : options of SimpleCorrelation, e.g. "subsamples=10"
+#   TOY_EVENTS       : generate toy events instead of Pythia (GenerateToyEvents.C),
+#                      with these generator options, e.g. "mean=40,jets=2"; above 100
+#                      tracks per event add multclamp to ANALYSIS_OPTIONS
+#   FORCE=1          : rerun every stage
+#
+# Stages, with their inputs and outputs in results/:
+#   generate_<i>   z01 macro + headers              -> shards/pythia_events_<i>.root
+#                  (toy macro + generator with TOY_EVENTS set)
+#   correlate_<i>  shards/pythia_events_<i>.root    -> shards/correlations_<i>.root
+#   merge          shards/correlations_*.root       -> correlations_with_jets.root
+#   quantification correlations_with_jets.root      -> quantification.txt
+#   plots          correlations_with_jets.root      -> figures/
+#   tables         quantification.txt               -> tables/
+# Every shard analyses its events as soon as its own generation is done; up
+# to <jobs> shards run at the same time. A stage is skipped when the content
+# hash of its inputs (files, code, parameters) is the one of its last
+# successful run and its outputs exist. Logs are in results/.pipeline/logs/.
 
 NEVENTS=${1:-1000000}
-WORKDIR=/Users/djkim/Documents/GitHub/draw_jet
+NSHARDS=${2:-4}
+JOBS=${3:-$(nproc 2>/dev/null || sysctl -n hw.ncpu 2>/dev/null || echo 4)}
+JETR=0.4
 
-echo "========================================"
-echo "Pythia Jet Correlation Analysis Workflow"
-echo "========================================"
-echo "Number of events: $NEVENTS"
-echo "Working directory: $WORKDIR"
-echo ""
+WORKDIR=$(cd "$(dirname "$0")" && pwd)
+cd "$WORKDIR" || exit 1
 
-cd $WORKDIR
-mkdir -p results
+RESULTS=results
+SHARDS=$RESULTS/shards
+STAMPS=$RESULTS/.pipeline
+LOGS=$STAMPS/logs
+mkdir -p "$SHARDS" "$LOGS"
 
-# Step 1: Generate Pythia events
-echo "========================================"
-echo "Step 1: Generating Pythia Events"
-echo "========================================"
-./run_standalone.sh $NEVENTS results/pythia_events.root 0.4
+EVENTS_PER_SHARD=$(( (NEVENTS + NSHARDS - 1) / NSHARDS ))
 
-if [ ! -f "results/pythia_events.root" ]; then
-    echo "Error: Pythia event generation failed!"
-    exit 1
-fi
-echo "✓ Pythia events generated"
-echo ""
+log() {
+    echo "[$(date +%H:%M:%S)] $*"
+}
 
-# Step 2: Run correlation analysis
-echo "========================================"
-echo "Step 2: Running Correlation Analysis"
-echo "========================================"
-cd jAnaSimple
-make clean && make
+# MD5 of stdin (md5sum on Linux, md5 on macOS)
+hash_stream() {
+    if command -v md5sum > /dev/null; then
+        md5sum | cut -d' ' -f1
+    else
+        md5 -q
+    fi
+}
 
-if [ $? -ne 0 ]; then
-    echo "Error: Compilation failed!"
-    exit 1
-fi
+# Names and contents of the given files; directories stand for all files in them
+content_of() {
+    local item f
+    for item in "$@"; do
+        if [ -d "$item" ]; then
+            find "$item" -type f | sort | while read -r f; do echo "$f"; cat "$f"; done
+        elif [ -f "$item" ]; then
+            echo "$item"
+            cat "$item"
+        else
+            echo "missing $item"
+        fi
+    done
+}
 
-echo "../results/pythia_events.root" > input_trees.txt
-./SimpleCorrelation input_trees.txt ../results/correlations_with_jets.root
+# run_stage <name> <inputs...> -- <outputs...> -- <command...>
+# Runs the command unless inputs and command are unchanged since its last
+# successful run and all outputs exist
+run_stage() {
+    local name=$1
+    shift
+    local inputs=() outputs=()
+    while [ "$1" != "--" ]; do inputs+=("$1"); shift; done
+    shift
+    while [ "$1" != "--" ]; do outputs+=("$1"); shift; done
+    shift
 
-if [ $? -ne 0 ]; then
-    echo "Error: Correlation analysis failed!"
-    exit 1
-fi
-cd ..
-echo "✓ Correlation analysis complete"
-echo ""
+    local key
+    key=$( { echo "$*"; content_of "${inputs[@]}"; } | hash_stream )
+    local stamp=$STAMPS/$name.hash
+    local upToDate=0
+    if [ -z "$FORCE" ] && [ -f "$stamp" ] && [ "$(cat "$stamp")" = "$key" ]; then
+        upToDate=1
+        for out in "${outputs[@]}"; do
+            [ -e "$out" ] || upToDate=0
+        done
+    fi
+    if [ $upToDate -eq 1 ]; then
+        log "$name: up to date"
+        return 0
+    fi
 
-# Step 3: Extract quantification metrics
-echo "========================================"
-echo "Step 3: Extracting Quantification Metrics"
-echo "========================================"
-root -l -b << EOF
-.L z03_ExtractQuantification.C
-ExtractQuantification("results/correlations_with_jets.root", "results/quantification.txt")
+    log "$name: running"
+    rm -f "$stamp"
+    if ! "$@" > "$LOGS/$name.log" 2>&1; then
+        log "$name: FAILED (see $LOGS/$name.log)"
+        return 1
+    fi
+    echo "$key" > "$stamp"
+    log "$name: done"
+}
+
+# run_macro <macro> <call>
+run_macro() {
+    root -l -b << EOF
+.L $1
+$2
 .q
 EOF
+}
 
-if [ ! -f "results/quantification.txt" ]; then
-    echo "Error: Quantification extraction failed!"
-    exit 1
-fi
-echo "✓ Quantification metrics extracted"
-echo ""
+generate_shard() {
+    if [ -n "${TOY_EVENTS+x}" ]; then
+        run_macro GenerateToyEvents.C+ "GenerateToyEvents($EVENTS_PER_SHARD, \"$1\", \"$TOY_EVENTS\", $2)" && [ -f "$1" ]
+    else
+        ./run_standalone.sh "$EVENTS_PER_SHARD" "$1" "$JETR" "$PTHAT_BINS" "$2" && [ -f "$1" ]
+    fi
+}
 
-# Step 4: Generate figures
-echo "========================================"
-echo "Step 4: Generating Figures"
-echo "========================================"
-root -l -b << EOF
-.L z04_PlotResults.C
-PlotResults("results/correlations_with_jets.root", "results/figures")
-.q
-EOF
-echo "✓ Figures generated"
-echo ""
+correlate_shard() {
+    echo "../$1" > "$SHARDS/input_$3.txt"
+    (cd jAnaSimple && ./SimpleCorrelation "../$SHARDS/input_$3.txt" "../$2" "$ANALYSIS_OPTIONS")
+}
+
+# Post-processing executables (z03-z05 compiled by make); fits on $JOBS threads,
+# with the fit cache in the top directory, figures on $JOBS worker processes
+extract_quantification() {
+    (cd jAnaSimple && FIT_CACHE=${FIT_CACHE:-../fit_cache} ./ExtractQuantification "../$1" "../$2" "$JOBS")
+}
+
+plot_results() {
+    (cd jAnaSimple && ./PlotResults "../$1" "../$2" "$JOBS")
+}
+
+generate_tables() {
+    (cd jAnaSimple && ./GenerateTables "../$1" "../$2")
+}
+
+merge_shards() {
+    ls "$SHARDS"/correlations_*.root | sed 's|^|../|' > "$SHARDS/merge_list.txt"
+    (cd jAnaSimple && ./MergeCorrelation "../$RESULTS/correlations_with_jets.root" "../$SHARDS/merge_list.txt" "$JOBS")
+}
+
+# Generation and correlation analysis of one shard, one after the other
+run_shard() {
+    local i=$1
+    local events=$SHARDS/pythia_events_$i.root
+    local correlations=$SHARDS/correlations_$i.root
+    if [ -n "${TOY_EVENTS+x}" ]; then
+        run_stage "generate_$i" GenerateToyEvents.C jAnaSimple/src/JToyEventGenerator.h jAnaSimple/src/JEventFrame.h \
+            -- "$events" -- generate_shard "$events" $((i + 1)) "$EVENTS_PER_SHARD" "toy:$TOY_EVENTS" || return 1
+    else
+        run_stage "generate_$i" z01_GeneratePythiaEvents.C PythiaEventBuilder.h PythiaInitCache.h run_standalone.sh \
+            -- "$events" -- generate_shard "$events" $((i + 1)) "$EVENTS_PER_SHARD" "$PTHAT_BINS" || return 1
+    fi
+    run_stage "correlate_$i" "$events" jAnaSimple/SimpleCorrelation jAnaSimple/libSimpleCorr.so \
+        -- "$correlations" -- correlate_shard "$events" "$correlations" "$i" "$ANALYSIS_OPTIONS"
+}
 
-# Step 5: Generate tables
 echo "========================================"
-echo "Step 5: Generating LaTeX Tables"
+echo "Pythia Jet Correlation Analysis Workflow"
 echo "========================================"
-root -l -b << EOF
-.L z05_GenerateTables.C
-GenerateTables("results/quantification.txt", "results/tables")
-.q
-EOF
-echo "✓ LaTeX tables generated"
+echo "Number of events: $NEVENTS ($NSHARDS shards of $EVENTS_PER_SHARD)"
+echo "Parallel jobs: $JOBS"
+echo "Working directory: $WORKDIR"
 echo ""
 
+# make rebuilds only what changed
+log "build: make -C jAnaSimple"
+if ! make -C jAnaSimple > "$LOGS/build.log" 2>&1; then
+    log "build: FAILED (see $LOGS/build.log)"
+    exit 1
+fi
+
+# Shards of previous runs with more shards must not enter the merge
+for f in "$SHARDS"/correlations_*.root; do
+    [ -e "$f" ] || continue
+    i=${f##*_}
+    i=${i%.root}
+    [ "$i" -ge "$NSHARDS" ] && rm -f "$f" "$SHARDS/pythia_events_$i.root" "$STAMPS"/*_"$i".hash
+done
+
+pids=()
+for ((i = 0; i < NSHARDS; i++)); do
+    while [ "$(jobs -rp | wc -l)" -ge "$JOBS" ]; do sleep 1; done
+    run_shard $i &
+    pids+=($!)
+done
+nFailed=0
+for pid in "${pids[@]}"; do
+    wait "$pid" || nFailed=$((nFailed + 1))
+done
+if [ $nFailed -gt 0 ]; then
+    log "$nFailed shard(s) failed"
+    exit 1
+fi
+
+shardOutputs=()
+for ((i = 0; i < NSHARDS; i++)); do shardOutputs+=("$SHARDS/correlations_$i.root"); done
+run_stage merge "${shardOutputs[@]}" jAnaSimple/MergeCorrelation jAnaSimple/libSimpleCorr.so \
+    -- "$RESULTS/correlations_with_jets.root" -- merge_shards || exit 1
+
+# Quantification and plots only need the merged correlations
+CORR=$RESULTS/correlations_with_jets.root
+run_stage quantification "$CORR" jAnaSimple/ExtractQuantification \
+    -- "$RESULTS/quantification.txt" \
+    -- extract_quantification "$CORR" "$RESULTS/quantification.txt" &
+quantPid=$!
+run_stage plots "$CORR" jAnaSimple/PlotResults \
+    -- "$RESULTS/figures" \
+    -- plot_results "$CORR" "$RESULTS/figures" &
+plotPid=$!
+wait $quantPid || exit 1
+
+run_stage tables "$RESULTS/quantification.txt" jAnaSimple/GenerateTables \
+    -- "$RESULTS/tables" \
+    -- generate_tables "$RESULTS/quantification.txt" "$RESULTS/tables" || exit 1
+wait $plotPid || exit 1
+
 # Summary
 echo "========================================"
 echo "Workflow Complete!"
 echo "========================================"
-echo "Results directory: results/"
-echo "  - Events: results/pythia_events.root"
-echo "  - Correlations: results/correlations_with_jets.root"
-echo "  - Quantification: results/quantification.txt"
-echo "  - Figures: results/figures/"
-echo "  - Tables: results/tables/"
+echo "Results directory: $RESULTS/"
+echo "  - Events: $SHARDS/pythia_events_*.root"
+echo "  - Correlations: $RESULTS/correlations_with_jets.root"
+echo "  - Quantification: $RESULTS/quantification.txt"
+echo "  - Figures: $RESULTS/figures/"
+echo "  - Tables: $RESULTS/tables/"
 echo "========================================"
@@ -1,7 +1,11 @@
 #!/bin/bash
 # Standalone script to run Pythia event generation without O2Physics conflicts
 # This script uses a minimal ROOT setup to avoid autoloading issues
-# Usage: ./run_standalone.sh [nEvents] [outputFile] [jetR]
+# Usage: ./run_standalone.sh [nEvents] [outputFile] [jetR] [pTHatBins] [seed] [traceFile]
+#   pTHatBins: optional comma separated pT-hat slice edges, e.g. "3,8,16,32,-1"
+#              (nEvents per slice, per-event cross-section weights)
+#   seed     : Pythia random seed, needed for independent shards (default: Pythia's)
+#   traceFile: optional Chrome/Perfetto trace of the generation stages
 
 # Check if ALICE environment is loaded
 if [ -z "$PYTHIA8" ] || [ -z "$FASTJET" ]; then
@@ -14,6 +18,9 @@ fi
 nEvents=${1:-1000}
 outputFile=${2:-pythia_events.root}
 jetR=${3:-0.4}
+pTHatBins=${4:-}
+seed=${5:--1}
+traceFile=${6:-}
 
 echo "========================================"
 echo "Standalone Pythia Event Generation"
@@ -23,6 +30,8 @@ echo "FASTJET: $FASTJET"
 echo "Events: $nEvents"
 echo "Output: $outputFile"
 echo "Jet R: $jetR"
+echo "pT-hat slices: ${pTHatBins:-none}"
+echo "Seed: $seed"
 echo ""
 
 # Run with minimal ROOT setup
@@ -74,7 +83,7 @@ cout << "  Output: $outputFile" << endl;
 cout << "  Jet R: $jetR" << endl;
 cout << "" << endl;
 
-GeneratePythiaEvents($nEvents, "$outputFile", $jetR);
+GeneratePythiaEvents($nEvents, "$outputFile", $jetR, "$pTHatBins", $seed, "$traceFile");
 EOF
 
 echo ""
@@ -2,7 +2,7 @@
 # Run correlation analysis using jAnaSimple
 # Usage: alienv setenv O2Physics/latest -c ./z02_RunCorrelationAnalysis.sh
 
-cd /Users/djkim/Documents/GitHub/draw_jet
+cd "$(dirname "$0")"
 
 echo "========================================"
 echo "Running Correlation Analysis"
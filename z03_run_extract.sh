@@ -1,7 +1,4 @@
 #!/bin/bash
-cd /Users/djkim/Documents/GitHub/draw_jet
-root -l -b << 'EOF'
-.L z03_ExtractQuantification.C
-ExtractQuantification("results/correlations_with_jets.root", "results/quantification.txt")
-.q
-EOF
+cd "$(dirname "$0")"
+make -C jAnaSimple ExtractQuantification || exit 1
+cd jAnaSimple && FIT_CACHE=${FIT_CACHE:-../fit_cache} ./ExtractQuantification ../results/correlations_with_jets.root ../results/quantification.txt
@@ -1,7 +1,4 @@
 #!/bin/bash
-cd /Users/djkim/Documents/GitHub/draw_jet
-root -l -b << 'EOF'
-.L z04_PlotResults.C
-PlotResults("results/correlations_with_jets.root", "results/figures")
-.q
-EOF
+cd "$(dirname "$0")"
+make -C jAnaSimple PlotResults || exit 1
+cd jAnaSimple && ./PlotResults ../results/correlations_with_jets.root ../results/figures
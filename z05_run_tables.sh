@@ -1,7 +1,4 @@
 #!/bin/bash
-cd /Users/djkim/Documents/GitHub/draw_jet
-root -l -b << 'EOF'
-.L z05_GenerateTables.C
-GenerateTables("results/quantification.txt", "results/tables")
-.q
-EOF
+cd "$(dirname "$0")"
+make -C jAnaSimple GenerateTables || exit 1
+cd jAnaSimple && ./GenerateTables ../results/quantification.txt ../results/tables